@@ -0,0 +1,28 @@
+import os
+import subprocess
+import sys
+import time
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TARGETS = ["tuple_get_ctb", "tuple_get_ctb_no_builtin", "tuple_get_std"]
+# libstdc++ ::std::tuple takes hours for 1000 elements
+TIMEOUT = 600
+
+def time_build(build_dir, target):
+    subprocess.run(["cmake", "--build", build_dir, "--target", "clean"], check=True, stdout=subprocess.DEVNULL)
+    begin = time.perf_counter()
+    try:
+        subprocess.run(["cmake", "--build", build_dir, "--target", target], check=True, stdout=subprocess.DEVNULL,
+                       timeout=TIMEOUT)
+    except subprocess.TimeoutExpired:
+        return f"> {TIMEOUT}s"
+    return f"{time.perf_counter() - begin:.2f}s"
+
+if __name__ == '__main__':
+    build_dir = os.path.join(PROJECT_DIR, "build-bench")
+    subprocess.run(
+        ["cmake", "-S", os.path.join(PROJECT_DIR, "bench"), "-B", build_dir, "-Wno-dev", *sys.argv[1:]],
+        check=True, stdout=subprocess.DEVNULL,
+    )
+    for target in TARGETS:
+        print(f"{target}: {time_build(build_dir, target)}")
@@ -0,0 +1,48 @@
+/* Compile-time cost of get<I> and get<T> on a BENCH_SIZE-element tuple
+ *
+ * Built three times by CMakeLists.txt: ctb::tuple, ctb::tuple without
+ * __type_pack_element, and ::std::tuple.
+ */
+#include <cstddef>
+#include <utility>
+
+#if defined(BENCH_STD_TUPLE)
+    #include <tuple>
+namespace bench = ::std;
+#else
+    #include <ctb/tuple.hh>
+namespace bench = ::ctb::tuple;
+#endif
+
+#ifndef BENCH_SIZE
+    #define BENCH_SIZE 1000
+#endif
+
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+template<::std::size_t I>
+struct tag {
+    ::std::size_t val;
+};
+
+template<::std::size_t... I>
+consteval ::std::size_t sum(::std::index_sequence<I...>) noexcept {
+    using bench::get;
+    bench::tuple<tag<I>...> t{tag<I>{I}...};
+    ::std::size_t res{};
+    ((res += get<I>(t).val + get<tag<I>>(t).val), ...);
+    return res;
+}
+
+static_assert(sum(::std::make_index_sequence<BENCH_SIZE>{}) == BENCH_SIZE * (BENCH_SIZE - 1));
+
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+
+int main() noexcept {
+    return 0;
+}
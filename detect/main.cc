@@ -50,6 +50,16 @@
     #pragma message("[[Detect]] pack-indexing: Failed")
 #endif
 
+#if defined(__has_builtin)
+    #if __has_builtin(__type_pack_element)
+        #pragma message("[[Detect]] type-pack-element: Success")
+    #else
+        #pragma message("[[Detect]] type-pack-element: Failed")
+    #endif
+#else
+    #pragma message("[[Detect]] type-pack-element: Failed")
+#endif
+
 int main() noexcept {
     return 0;
 }
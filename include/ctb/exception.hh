@@ -5,6 +5,7 @@
 #endif // __cpp_concepts < 201907L
 
 #include <new>
+#include <cstddef>
 #include <utility>
 #include <type_traits>
 #include <concepts>
@@ -135,13 +136,109 @@ constexpr bool is_unexpected_v<unexpected<T>> = true;
 template<typename T>
 concept is_unexpected = ::ctb::exception::details::is_unexpected_v<::std::remove_cvref_t<T>>;
 
-template<typename Ok, typename Fail>
-class expected {
+/* Values of T that are never valid, customization point of expected
+ *
+ * A specialization provides make(), returning such a value, and is_niche(val).
+ * expected<T, Fail> with an empty Fail then stores the disengaged state as
+ * that value instead of a separate flag, so sizeof(optional<T>) == sizeof(T).
+ * Constructing an engaged expected from the niche value terminates.
+ * No type has a niche by default, optional<T*>{nullptr} is engaged;
+ * wrap the pointer in non_null to opt in.
+ *
+ * Usage: template<>
+ *        struct ctb::exception::niche_traits<color> {
+ *            static constexpr color make() noexcept { return static_cast<color>(0xff); }
+ *            static constexpr bool is_niche(color c) noexcept { return c == make(); }
+ *        };
+ */
+template<typename T>
+struct niche_traits {};
+
+/* Pointer that is never null, nullptr is its niche
+ *
+ * Constructing it from nullptr terminates.
+ *
+ * Usage: optional<non_null<int*>> x{non_null{&a}}; // sizeof(x) == sizeof(int*)
+ */
+template<typename T>
+    requires (::std::is_pointer_v<T>)
+class non_null {
+    T ptr_;
+
+    friend struct ::ctb::exception::niche_traits<non_null<T>>;
+
+    constexpr non_null(::std::nullptr_t, int) noexcept
+        : ptr_{nullptr} {
+    }
+
 public:
+    non_null() = delete;
+
+    constexpr explicit non_null(T ptr) noexcept
+        : ptr_{ptr} {
+        ::ctb::exception::assert_true(ptr != nullptr);
+    }
+
+    non_null(::std::nullptr_t) = delete;
+
+    [[nodiscard]]
+    constexpr T get() const noexcept {
+        return this->ptr_;
+    }
+
+    [[nodiscard]]
+    constexpr operator T() const noexcept {
+        return this->ptr_;
+    }
+
+    [[nodiscard]]
+    constexpr decltype(auto) operator*() const noexcept {
+        return *this->ptr_;
+    }
+
+    [[nodiscard]]
+    constexpr T operator->() const noexcept {
+        return this->ptr_;
+    }
+
+    [[nodiscard]]
+    friend constexpr bool operator==(non_null const&, non_null const&) noexcept = default;
+};
+
+template<typename T>
+struct niche_traits<non_null<T>> {
+    [[nodiscard]]
+    static constexpr non_null<T> make() noexcept {
+        return non_null<T>{nullptr, 0};
+    }
+
+    [[nodiscard]]
+    static constexpr bool is_niche(non_null<T> const& val) noexcept {
+        return val.ptr_ == nullptr;
+    }
+};
+
+template<typename T>
+concept has_niche = requires(T const& val) {
+    { ::ctb::exception::niche_traits<T>::make() } -> ::std::same_as<T>;
+    { ::ctb::exception::niche_traits<T>::is_niche(val) } -> ::std::same_as<bool>;
+};
+
+namespace details {
+
+/* Storage of expected, Ok and Fail share a union and a flag tells which one is alive
+ *
+ * Both storages provide ok_, fail_, is_ok_(), assign_ok_, assign_fail_ and swap_,
+ * expected builds every accessor on them once.
+ */
+template<typename Ok, typename Fail>
+class expected_storage_ {
+protected:
     using value_type = ::std::remove_cvref_t<Ok>;
     using error_type = ::std::remove_cvref_t<Fail>;
 
-private:
+    static constexpr bool is_swappable_{::std::is_move_assignable_v<Ok> && ::std::is_move_assignable_v<Fail>};
+
     union {
         value_type ok_;
         error_type fail_;
@@ -150,145 +247,224 @@ private:
     bool has_value_;
 
 public:
-    constexpr expected() noexcept = delete;
-
-    constexpr expected(Ok const& ok) noexcept
+    constexpr expected_storage_(Ok const& ok) noexcept
         requires (::std::is_copy_constructible_v<Ok>)
         : ok_{ok},
           has_value_{true} {
     }
 
-    constexpr expected(Ok&& ok) noexcept
+    constexpr expected_storage_(Ok&& ok) noexcept
         requires (::std::is_move_constructible_v<Ok>)
         : ok_{::std::move(ok)},
           has_value_{true} {
     }
 
-    constexpr expected(unexpected<Fail> const& fail) noexcept
+    constexpr expected_storage_(unexpected<Fail> const& fail) noexcept
         requires (::std::is_copy_constructible_v<Fail>)
         : fail_{fail.val_},
           has_value_{false} {
     }
 
-    constexpr expected(unexpected<Fail>&& fail) noexcept
+    constexpr expected_storage_(unexpected<Fail>&& fail) noexcept
         requires (::std::is_move_constructible_v<Fail>)
         : fail_{::std::move(fail.val_)},
           has_value_{false} {
     }
 
-    constexpr expected(expected<Ok, Fail> const& other) noexcept
+    constexpr expected_storage_(expected_storage_ const& other) noexcept
         : has_value_{other.has_value_} {
-        if (this->has_value()) [[likely]] {
+        if (this->has_value_) [[likely]] {
             new (&this->ok_) value_type(other.ok_);
         } else {
             new (&this->fail_) error_type(other.fail_);
         }
     }
 
-    constexpr expected(expected<Ok, Fail>&& other) noexcept
-        : has_value_{::std::move(other.has_value_)} {
-        if (this->has_value()) [[likely]] {
+    constexpr expected_storage_(expected_storage_&& other) noexcept
+        : has_value_{other.has_value_} {
+        if (this->has_value_) [[likely]] {
             new (&this->ok_) value_type(::std::move(other.ok_));
         } else {
             new (&this->fail_) error_type(::std::move(other.fail_));
         }
     }
 
-    constexpr ~expected() noexcept {
-        if (this->has_value()) [[likely]] {
+    constexpr ~expected_storage_() noexcept {
+        if (this->has_value_) [[likely]] {
             this->ok_.~value_type();
         } else {
             this->fail_.~error_type();
         }
     }
 
-    template<typename T>
-        requires (::std::same_as<::std::remove_cvref_t<T>, Ok> &&
-                  (::std::is_copy_assignable_v<T> || ::std::is_move_assignable_v<T>))
-    constexpr auto&& operator=(T&& ok) & noexcept {
-        if (this->has_value()) [[likely]] {
-            this->ok_ = ::std::forward<T>(ok);
+    constexpr expected_storage_& operator=(expected_storage_ const& other) noexcept {
+        if (other.has_value_) [[likely]] {
+            this->assign_ok_(other.ok_);
         } else {
-            this->fail_.~error_type();
-            new (&this->ok_) value_type(::std::forward<T>(ok));
-            this->has_value_ = true;
+            this->assign_fail_(other.fail_);
         }
-        return (*this);
+        return *this;
     }
 
-    template<is_unexpected T>
-    constexpr auto&& operator=(T const& fail) & noexcept {
-        this->has_value_ = false;
-        this->fail_ = fail.val_;
+    constexpr expected_storage_& operator=(expected_storage_&& other) noexcept {
+        if (other.has_value_) [[likely]] {
+            this->assign_ok_(::std::move(other.ok_));
+        } else {
+            this->assign_fail_(::std::move(other.fail_));
+        }
         return *this;
     }
 
-    template<is_unexpected T>
-    constexpr auto&& operator=(T&& fail) & noexcept {
-        this->has_value_ = false;
-        this->fail_ = ::std::move(fail.val_);
-        return *this;
+protected:
+    [[nodiscard]]
+    constexpr bool is_ok_() const noexcept {
+        return this->has_value_;
     }
 
-    constexpr auto&& operator=(expected<Ok, Fail> const& other) & noexcept {
-        this->has_value_ = other.has_value_;
-        if (this->has_value()) [[likely]] {
-            this->ok_ = other.ok_;
+    template<typename T>
+    constexpr void assign_ok_(T&& ok) noexcept {
+        if (this->has_value_) [[likely]] {
+            this->ok_ = ::std::forward<T>(ok);
         } else {
-            this->fail_ = other.fail_;
+            this->fail_.~error_type();
+            new (&this->ok_) value_type(::std::forward<T>(ok));
+            this->has_value_ = true;
         }
-        return *this;
     }
 
-    constexpr auto&& operator=(expected<Ok, Fail>&& other) & noexcept {
-        this->has_value_ = other.has_value_;
-        if (this->has_value()) [[likely]] {
-            this->ok_ = ::std::move(other.ok_);
+    template<typename T>
+    constexpr void assign_fail_(T&& fail) noexcept {
+        if (this->has_value_) [[likely]] {
+            this->ok_.~value_type();
+            new (&this->fail_) error_type(::std::forward<T>(fail));
+            this->has_value_ = false;
         } else {
-            this->fail_ = ::std::move(other.fail_);
+            this->fail_ = ::std::forward<T>(fail);
         }
-        return *this;
     }
 
-    template<typename T>
-        requires (::std::same_as<::std::remove_cvref_t<T>, expected<Ok, Fail>> && ::std::is_move_assignable_v<Ok> &&
-                  ::std::is_move_assignable_v<Fail>)
-    constexpr void swap(T&& other) & noexcept {
-        if (this->has_value()) [[likely]] {
-            if (other.has_value()) [[likely]] {
-                Ok tmp{::std::move(this->ok_)};
-                this->ok_ = ::std::move(other.ok_);
-                other.ok_ = ::std::move(tmp);
-            } else {
-                Ok tmp{::std::move(this->ok_)};
-                this->ok_ = ::std::move(other.fail_);
-                other.fail_ = ::std::move(tmp);
-                this->has_value_ = false;
-                other.has_value_ = true;
-            }
+    constexpr void swap_(expected_storage_& other) noexcept {
+        if (this->has_value_ && other.has_value_) {
+            value_type tmp{::std::move(this->ok_)};
+            this->ok_ = ::std::move(other.ok_);
+            other.ok_ = ::std::move(tmp);
+        } else if (!this->has_value_ && !other.has_value_) {
+            error_type tmp{::std::move(this->fail_)};
+            this->fail_ = ::std::move(other.fail_);
+            other.fail_ = ::std::move(tmp);
         } else {
-            if (other.has_value()) [[likely]] {
-                Fail tmp{::std::move(this->fail_)};
-                this->fail_ = ::std::move(other.ok_);
-                other.fail_ = ::std::move(tmp);
-                this->has_value_ = true;
-                other.has_value_ = false;
-            } else {
-                Fail tmp{::std::move(this->fail_)};
-                this->fail_ = ::std::move(other.fail_);
-                other.fail_ = ::std::move(tmp);
-            }
+            auto& engaged = this->has_value_ ? *this : other;
+            auto& disengaged = this->has_value_ ? other : *this;
+            value_type tmp{::std::move(engaged.ok_)};
+            engaged.assign_fail_(::std::move(disengaged.fail_));
+            disengaged.assign_ok_(::std::move(tmp));
         }
     }
+};
 
-#if __has_cpp_attribute(__gnu__::__always_inline__)
-    [[__gnu__::__always_inline__]]
-#elif __has_cpp_attribute(msvc::forceinline)
-    [[msvc::forceinline]]
+/* Ok has a niche and Fail is empty, the niche value of ok_ means there is no value
+ */
+template<typename Ok, typename Fail>
+    requires (has_niche<::std::remove_cvref_t<Ok>> && ::std::is_empty_v<::std::remove_cvref_t<Fail>> &&
+              ::std::default_initializable<::std::remove_cvref_t<Fail>>)
+class expected_storage_<Ok, Fail> {
+protected:
+    using value_type = ::std::remove_cvref_t<Ok>;
+    using error_type = ::std::remove_cvref_t<Fail>;
+    using niche_ = ::ctb::exception::niche_traits<value_type>;
+
+    static constexpr bool is_swappable_{::std::is_move_assignable_v<Ok>};
+
+    value_type ok_;
+#if __has_cpp_attribute(msvc::no_unique_address)
+    [[msvc::no_unique_address]]
+#elif __has_cpp_attribute(no_unique_address)
+    [[no_unique_address]]
 #endif
+    error_type fail_{};
+
+public:
+    constexpr expected_storage_(Ok const& ok) noexcept
+        requires (::std::is_copy_constructible_v<Ok>)
+        : ok_{ok} {
+        ::ctb::exception::assert_false(niche_::is_niche(this->ok_));
+    }
+
+    constexpr expected_storage_(Ok&& ok) noexcept
+        requires (::std::is_move_constructible_v<Ok>)
+        : ok_{::std::move(ok)} {
+        ::ctb::exception::assert_false(niche_::is_niche(this->ok_));
+    }
+
+    constexpr expected_storage_(unexpected<Fail> const&) noexcept
+        : ok_{niche_::make()} {
+    }
+
+    constexpr expected_storage_(unexpected<Fail>&&) noexcept
+        : ok_{niche_::make()} {
+    }
+
+protected:
     [[nodiscard]]
-    constexpr auto&& has_value() const& noexcept {
-        return this->has_value_;
+    constexpr bool is_ok_() const noexcept {
+        return !niche_::is_niche(this->ok_);
+    }
+
+    template<typename T>
+    constexpr void assign_ok_(T&& ok) noexcept {
+        this->ok_ = ::std::forward<T>(ok);
+        ::ctb::exception::assert_false(niche_::is_niche(this->ok_));
+    }
+
+    template<typename T>
+    constexpr void assign_fail_(T&&) noexcept {
+        this->ok_ = niche_::make();
+    }
+
+    constexpr void swap_(expected_storage_& other) noexcept {
+        value_type tmp{::std::move(this->ok_)};
+        this->ok_ = ::std::move(other.ok_);
+        other.ok_ = ::std::move(tmp);
+    }
+};
+
+} // namespace details
+
+/* Either an Ok or a Fail
+ *
+ * Accessors are shared, the storage is a union with a flag, or only Ok when
+ * Ok has a niche and Fail is empty, see niche_traits.
+ */
+template<typename Ok, typename Fail>
+class expected : private ::ctb::exception::details::expected_storage_<Ok, Fail> {
+    using storage_ = ::ctb::exception::details::expected_storage_<Ok, Fail>;
+
+public:
+    using value_type = ::std::remove_cvref_t<Ok>;
+    using error_type = ::std::remove_cvref_t<Fail>;
+
+    constexpr expected() noexcept = delete;
+
+    using storage_::storage_;
+
+    template<typename T>
+        requires (::std::same_as<::std::remove_cvref_t<T>, Ok> &&
+                  (::std::is_copy_assignable_v<T> || ::std::is_move_assignable_v<T>))
+    constexpr auto&& operator=(T&& ok) & noexcept {
+        this->assign_ok_(::std::forward<T>(ok));
+        return (*this);
+    }
+
+    template<is_unexpected T>
+    constexpr auto&& operator=(T&& fail) & noexcept {
+        this->assign_fail_(::std::forward<T>(fail).val_);
+        return *this;
+    }
+
+    template<typename T>
+        requires (::std::same_as<::std::remove_cvref_t<T>, expected<Ok, Fail>> && storage_::is_swappable_)
+    constexpr void swap(T&& other) & noexcept {
+        this->swap_(static_cast<storage_&>(other));
     }
 
 #if __has_cpp_attribute(__gnu__::__always_inline__)
@@ -297,8 +473,8 @@ public:
     [[msvc::forceinline]]
 #endif
     [[nodiscard]]
-    constexpr auto&& has_value() const&& noexcept {
-        return ::std::move(this->has_value_);
+    constexpr bool has_value() const noexcept {
+        return this->is_ok_();
     }
 
     /**
@@ -329,6 +505,30 @@ public:
         return ::std::move(this->ok_);
     }
 
+    template<bool ndebug = false>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    constexpr auto&& value() & noexcept {
+        ::ctb::exception::assert_true<ndebug>(this->has_value());
+        return this->ok_;
+    }
+
+    template<bool ndebug = false>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    constexpr auto&& value() && noexcept {
+        ::ctb::exception::assert_true<ndebug>(this->has_value());
+        return ::std::move(this->ok_);
+    }
+
     /**
      * @brief get the error value from an expected
      */
@@ -5,6 +5,7 @@
 #endif // __cpp_concepts < 201907L
 
 #include "tuple.hh"
+#include <compare>
 #include <type_traits>
 
 #ifdef CTB_N_STL_SUPPORT
@@ -17,17 +18,10 @@
 
 namespace ctb::namedtuple::details {
 
-template<string::string First, string::string... Rest>
-struct names : names<Rest...> {
-    static constexpr auto current_val{First};
-    using next_name = names<Rest...>;
-};
-
-template<string::string Str>
-struct names<Str> {
-    static constexpr auto current_val{Str};
-    using next_name = void;
-};
+/* A flat list of field names
+ */
+template<string::string... Str>
+struct names {};
 
 template<typename>
 constexpr bool is_names_ = false;
@@ -38,33 +32,61 @@ constexpr bool is_names_<names<Str...>> = true;
 template<typename T>
 concept is_names = is_names_<::std::remove_cvref_t<T>>;
 
-template<::std::size_t N, is_names Names, ::std::size_t index_ = 0>
+template<::std::size_t N, string::string... Str>
+[[nodiscard]]
+consteval auto get_name_(names<Str...>) noexcept {
+    static_assert(N < sizeof...(Str), "index out of range");
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+    return tuple::get<N>(tuple::tuple<::std::remove_cvref_t<decltype(Str)>...>{Str...});
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+}
+
+template<::std::size_t N, is_names Names>
 [[nodiscard]]
 consteval auto get_name() noexcept {
-    if constexpr (index_ == N) {
-        return Names::current_val;
-    } else {
-        static_assert(!::std::is_void_v<typename Names::next_name>, "index out of range");
-        return get_name<N, typename Names::next_name, index_ + 1>();
-    }
+    return get_name_<N>(Names{});
 }
 
-template<is_names Names, ::std::size_t counter = 0>
+template<string::string... Str>
 [[nodiscard]]
-consteval ::std::size_t get_size_() noexcept {
-    if constexpr (::std::is_void_v<typename Names::next_name>) {
-        return counter + 1;
-    } else {
-        return get_size_<typename Names::next_name, counter + 1>();
-    }
+consteval ::std::size_t get_size_(names<Str...>) noexcept {
+    return sizeof...(Str);
 }
 
 template<is_names Names>
 [[nodiscard]]
 consteval ::std::size_t get_size() noexcept {
-    return get_size_<Names>();
+    return get_size_(Names{});
+}
+
+template<string::string str, string::string... Str>
+[[nodiscard]]
+consteval ::std::size_t get_index_(names<Str...>) noexcept {
+    ::std::size_t i{}, res{sizeof...(Str)};
+    static_cast<void>(((Str == str ? (res = i, true) : (++i, false)) || ...));
+    return res;
+}
+
+/* index of the name str in Names, get_size<Names>() if there is not
+ *
+ * One fold over all names, no recursive instantiation.
+ */
+template<string::string str, is_names Names>
+[[nodiscard]]
+consteval ::std::size_t get_index() noexcept {
+    return get_index_<str>(Names{});
 }
 
+/* From does not truncate a floating-point value into the integer To
+ */
+template<typename To, typename From>
+concept is_non_truncating_ = !(::std::is_integral_v<To> && ::std::is_floating_point_v<::std::remove_cvref_t<From>>);
+
 } // namespace ctb::namedtuple::details
 
 namespace ctb::namedtuple {
@@ -78,18 +100,28 @@ struct namedtuple {
     using names = Names;
     tuple::tuple<Args...> tuple;
 
-    constexpr namedtuple(Args&&... args) {
+    constexpr namedtuple() noexcept = default;
+
+    /* fields in declaration order, each one constructed in place from its argument
+     *
+     * Other conversions are implicit, but an integer field rejects a floating-point argument.
+     * No destructor or copy is declared, so namedtuple of trivially copyable
+     * fields is trivially copyable and moves move.
+     */
 #if defined(__clang__)
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wmissing-braces"
 #endif
-        this->tuple = tuple::tuple{::std::forward<Args>(args)...};
+    template<typename... Ts>
+        requires (sizeof...(Ts) == sizeof...(Args) && (::std::constructible_from<Args, Ts&&> && ...) &&
+                  (details::is_non_truncating_<Args, Ts&&> && ...) &&
+                  !(sizeof...(Ts) == 1 && (::std::is_same_v<::std::remove_cvref_t<Ts>, namedtuple> && ...)))
+    constexpr namedtuple(Ts&&... args) noexcept
+        : tuple{Args(::std::forward<Ts>(args))...} {
+    }
 #if defined(__clang__)
     #pragma clang diagnostic pop
 #endif
-    }
-
-    constexpr ~namedtuple() noexcept = default;
 };
 
 template<string::string... Str, typename... Args>
@@ -99,29 +131,68 @@ constexpr auto make_namedtuple(Args&&... args) noexcept {
     return namedtuple<names<Str...>, ::std::decay_t<Args>...>{::std::forward<Args>(args)...};
 }
 
+namespace details {
+
+template<typename T>
+constexpr bool is_namedtuple_ = false;
+
+template<is_names Names, typename... Args>
+constexpr bool is_namedtuple_<namedtuple<Names, Args...>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_namedtuple = details::is_namedtuple_<::std::remove_cvref_t<T>>;
+
+/* compare the fields of namedtuples with the same names, see ctb::tuple::operator==
+ */
+template<details::is_names Names, typename... Args, typename... Brgs>
+    requires requires(tuple::tuple<Args...> const& lhs, tuple::tuple<Brgs...> const& rhs) { lhs == rhs; }
+[[nodiscard]]
+constexpr bool operator==(namedtuple<Names, Args...> const& lhs, namedtuple<Names, Brgs...> const& rhs) noexcept {
+    return lhs.tuple == rhs.tuple;
+}
+
+template<details::is_names Names, typename... Args, typename... Brgs>
+    requires requires(tuple::tuple<Args...> const& lhs, tuple::tuple<Brgs...> const& rhs) { lhs <=> rhs; }
+[[nodiscard]]
+constexpr auto operator<=>(namedtuple<Names, Args...> const& lhs, namedtuple<Names, Brgs...> const& rhs) noexcept {
+    return lhs.tuple <=> rhs.tuple;
+}
+
 /* get namedtuple element by name
+ *
+ * Returns a reference with the same value category and constness as nt.
  *
  * Usage: get<"name">(nt)
  */
-template<string::string str, ::std::size_t index = 0, details::is_names Names, typename... Args>
+template<string::string str, is_namedtuple NT>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
 [[nodiscard]]
-constexpr auto get(namedtuple<Names, Args...> nt) noexcept {
-    static_assert(index < details::get_size<Names>(), "index out of range");
-    if constexpr (details::get_name<index, Names>() == str) {
-        return tuple::get<index>(nt.tuple);
-    } else {
-        return get<str, index + 1>(nt);
-    }
+constexpr auto&& get(NT&& nt) noexcept {
+    using names_type = typename ::std::remove_cvref_t<NT>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return tuple::get<index>(::std::forward<NT>(nt).tuple);
 }
 
 /* get namedtuple element by index
  *
  * Usage: get<1>(nt)
  */
-template<::std::size_t N, details::is_names Names, typename... Args>
+template<::std::size_t N, is_namedtuple NT>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
 [[nodiscard]]
-constexpr auto get(namedtuple<Names, Args...> nt) noexcept {
-    return tuple::get<N>(nt.tuple);
+constexpr auto&& get(NT&& nt) noexcept {
+    return tuple::get<N>(::std::forward<NT>(nt).tuple);
 }
 
 } // namespace ctb::namedtuple
@@ -134,5 +205,5 @@ struct std::tuple_size<::ctb::namedtuple::namedtuple<Names, Args...>>
 
 template<::std::size_t N, ::ctb::namedtuple::details::is_names Names, typename... Args>
 struct std::tuple_element<N, ::ctb::namedtuple::namedtuple<Names, Args...>> {
-    using type = decltype(::ctb::tuple::get<N>(::std::declval<::ctb::namedtuple::namedtuple<Names, Args...>>().tuple));
+    using type = ::ctb::utils::pack_indexing_t<N, Args...>;
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../tuple/binary.hh"
+#include "../utils.hh"
+
+/* Flat binary encoding of namedtuple, see ctb/tuple/binary.hh
+ *
+ * The field names are part of the schema hash, so renaming a field is
+ * detected like changing its type.
+ */
+template<::ctb::namedtuple::details::is_names Names, typename... Args>
+    requires (::ctb::tuple::details::is_wire_type_<Args> && ...)
+struct ctb::tuple::details::wire_traits_<::ctb::namedtuple::namedtuple<Names, Args...>> {
+    using type_ = ::ctb::namedtuple::namedtuple<Names, Args...>;
+    using tuple_traits_ = wire_traits_<::ctb::tuple::tuple<Args...>>;
+
+    static constexpr ::std::size_t size{tuple_traits_::size};
+
+    template<::std::size_t I>
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash_field_(::std::uint64_t h) noexcept {
+        constexpr auto name = ::ctb::namedtuple::details::get_name<I, Names>();
+        for (auto chr : name) {
+            // through the unsigned code unit, a signed char would sign-extend on some platforms only
+            h = details::hash_combine_(h, static_cast<::std::make_unsigned_t<decltype(chr)>>(chr));
+        }
+        h = details::hash_combine_(h, name.size());
+        return wire_traits_<::ctb::utils::pack_indexing_t<I, Args...>>::hash(h);
+    }
+
+    template<::std::size_t... I>
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash_fields_(::std::uint64_t h, ::std::index_sequence<I...>) noexcept {
+        ((h = wire_traits_::hash_field_<I>(h)), ...);
+        return h;
+    }
+
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash(::std::uint64_t h) noexcept {
+        h = details::hash_combine_(h, static_cast<::std::uint64_t>(wire_code_::namedtuple_begin));
+        h = wire_traits_::hash_fields_(h, ::std::index_sequence_for<Args...>{});
+        return details::hash_combine_(h, static_cast<::std::uint64_t>(wire_code_::namedtuple_end));
+    }
+
+    [[nodiscard]]
+    static bool valid(::std::byte const* in) noexcept {
+        return tuple_traits_::valid(in);
+    }
+
+    static void write(type_ const& val, ::std::byte* out) noexcept {
+        tuple_traits_::write(val.tuple, out);
+    }
+
+    static void read(::std::byte const* in, type_& val) noexcept {
+        tuple_traits_::read(in, val.tuple);
+    }
+};
+
+namespace ctb::namedtuple {
+
+/* Write nt into out, returns tuple::wire_size<NT>, nullopt if out is too small
+ */
+template<details::is_names Names, typename... Args>
+    requires (::ctb::tuple::details::is_wire_type_<namedtuple<Names, Args...>>)
+[[nodiscard]]
+inline exception::optional<::std::size_t> encode(namedtuple<Names, Args...> const& nt,
+                                                 ::std::span<::std::byte> out) noexcept {
+    return ::ctb::tuple::details::encode_(nt, out);
+}
+
+template<typename NT>
+    requires (is_namedtuple<NT> && ::ctb::tuple::details::is_wire_type_<NT>)
+[[nodiscard]]
+inline exception::expected<NT, ::ctb::tuple::binary_errc> decode(::std::span<::std::byte const> in) noexcept {
+    return ::ctb::tuple::details::decode_<NT>(in);
+}
+
+} // namespace ctb::namedtuple
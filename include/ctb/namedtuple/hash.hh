@@ -0,0 +1,43 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "../namedtuple.hh"
+#include "../tuple/hash.hh"
+
+/* ::std::hash for namedtuple, and the hash of a named subset of its fields
+ *
+ * Usage: std::unordered_map<order, int> map;
+ *        hash_fields<"sym", "venue">(o);
+ */
+namespace ctb::namedtuple {
+
+/* hash of the fields named Str, in the order given
+ *
+ * Equal for two namedtuples that agree on those fields, whatever their other fields.
+ */
+template<string::string... Str, is_namedtuple NT>
+    requires (sizeof...(Str) != 0)
+[[nodiscard]]
+inline ::std::size_t hash_fields(NT const& nt) noexcept {
+    using names_type = typename NT::names;
+    static_assert(((details::get_index<Str, names_type>() < details::get_size<names_type>()) && ...),
+                  "ctb::namedtuple::NameError: no such field");
+    return tuple::details::hash_fields_<details::get_index<Str, names_type>()...>(nt.tuple);
+}
+
+} // namespace ctb::namedtuple
+
+template<::ctb::namedtuple::details::is_names Names, typename... Args>
+    requires (::ctb::tuple::details::is_hashable_<::ctb::tuple::tuple<Args...>>)
+struct std::hash<::ctb::namedtuple::namedtuple<Names, Args...>> {
+    [[nodiscard]]
+    ::std::size_t operator()(::ctb::namedtuple::namedtuple<Names, Args...> const& nt) const noexcept {
+        return ::std::hash<::ctb::tuple::tuple<Args...>>{}(nt.tuple);
+    }
+};
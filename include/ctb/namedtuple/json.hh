@@ -0,0 +1,548 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "lookup.hh"
+
+/* JSON objects to and from namedtuple
+ *
+ * The key fragments `{"name":` and `,"name":` are concatenated at compile
+ * time, so writing a key is a single copy. Keys being parsed are dispatched
+ * to their field with field_index.
+ *
+ * Supported field types: bool, integers, floating point, string-likes
+ * (::std::string for from_json) and nested namedtuple.
+ *
+ * Usage: auto len = to_json(nt, buf);
+ *        auto res = from_json(text, nt);
+ */
+namespace ctb::namedtuple {
+
+enum class json_errc : unsigned char {
+    unexpected_end = 1,
+    syntax_error,
+    type_mismatch,
+    out_of_range,
+};
+
+namespace details {
+
+template<string::string str>
+consteval bool is_json_name_() noexcept {
+    for (auto chr : str) {
+        if (chr == '"' || chr == '\\' || static_cast<::std::uint32_t>(chr) < 0x20) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* `{"name":` for the first field, `,"name":` for the others
+ */
+template<::std::size_t I, string::string str>
+[[nodiscard]]
+consteval auto make_json_key_() noexcept {
+    static_assert(details::is_json_name_<str>(), "ctb::namedtuple::JsonError: names can not be escaped");
+    if constexpr (I == 0) {
+        return string::concat("{\"", string::code_cvt<char>(str), "\":");
+    } else {
+        return string::concat(",\"", string::code_cvt<char>(str), "\":");
+    }
+}
+
+template<::std::size_t I, typename Names>
+inline constexpr auto json_key_{details::make_json_key_<I, details::get_name<I, Names>()>()};
+
+template<typename T>
+concept is_json_string_ = ::std::is_convertible_v<T const&, ::std::string_view>;
+
+/* The output cursor, every write fails once the buffer is exhausted
+ */
+struct json_writer_ {
+    char* cur_;
+    char* end_;
+
+    [[nodiscard]]
+    bool write_(char const* data, ::std::size_t size) noexcept {
+        if (static_cast<::std::size_t>(this->end_ - this->cur_) < size) [[unlikely]] {
+            return false;
+        }
+        ::std::memcpy(this->cur_, data, size);
+        this->cur_ += size;
+        return true;
+    }
+
+    [[nodiscard]]
+    bool write_(char chr) noexcept {
+        return this->write_(&chr, 1);
+    }
+
+    [[nodiscard]]
+    bool write_string_(::std::string_view str) noexcept {
+        constexpr char hex[]{"0123456789abcdef"};
+        if (!this->write_('"')) {
+            return false;
+        }
+        for (auto chr : str) {
+            auto const code = static_cast<unsigned char>(chr);
+            bool ok{};
+            if (chr == '"' || chr == '\\') {
+                char const esc[]{'\\', chr};
+                ok = this->write_(esc, 2);
+            } else if (code < 0x20) {
+                char const esc[]{'\\', 'u', '0', '0', hex[code >> 4], hex[code & 0xf]};
+                ok = this->write_(esc, 6);
+            } else {
+                ok = this->write_(chr);
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        return this->write_('"');
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool write_value_(T const& val) noexcept {
+        if constexpr (::std::is_same_v<T, bool>) {
+            return val ? this->write_("true", 4) : this->write_("false", 5);
+        } else if constexpr (::std::is_floating_point_v<T>) {
+            if (val != val || val == ::std::numeric_limits<T>::infinity() ||
+                val == -::std::numeric_limits<T>::infinity()) {
+                return this->write_("null", 4);
+            }
+            auto const res = ::std::to_chars(this->cur_, this->end_, val);
+            this->cur_ = res.ptr;
+            return res.ec == ::std::errc{};
+        } else if constexpr (::std::is_integral_v<T>) {
+            auto const res = ::std::to_chars(this->cur_, this->end_, val);
+            this->cur_ = res.ptr;
+            return res.ec == ::std::errc{};
+        } else if constexpr (is_json_string_<T>) {
+            return this->write_string_(::std::string_view{val});
+        } else if constexpr (is_namedtuple<T>) {
+            return this->write_object_(val);
+        } else {
+            static_assert(false && sizeof(T), "ctb::namedtuple::JsonError: unsupported field type");
+        }
+    }
+
+    template<typename NT>
+    [[nodiscard]]
+    bool write_object_(NT const& nt) noexcept {
+        using names_type = typename NT::names;
+        constexpr auto size = details::get_size<names_type>();
+        if constexpr (size == 0) {
+            return this->write_("{}", 2);
+        } else {
+            return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+                return ((this->write_(json_key_<I, names_type>.str.arr, json_key_<I, names_type>.size()) &&
+                         this->write_value_(::ctb::namedtuple::get<I>(nt))) &&
+                        ...) &&
+                       this->write_('}');
+            }(::std::make_index_sequence<size>{});
+        }
+    }
+};
+
+} // namespace details
+
+/* Serialize nt as a JSON object into out
+ *
+ * Returns the number of characters written, nullopt if out is too small.
+ */
+template<typename NT>
+    requires (is_namedtuple<NT>)
+[[nodiscard]]
+inline exception::optional<::std::size_t> to_json(NT const& nt, ::std::span<char> out) noexcept {
+    details::json_writer_ writer{out.data(), out.data() + out.size()};
+    if (!writer.write_object_(nt)) {
+        return exception::nullopt;
+    }
+    return static_cast<::std::size_t>(writer.cur_ - out.data());
+}
+
+namespace details {
+
+/* The input cursor, the first error is kept in err_
+ */
+struct json_reader_ {
+    ::std::string_view in_;
+    ::std::size_t pos_{};
+    json_errc err_{};
+
+    [[nodiscard]]
+    bool fail_(json_errc err) noexcept {
+        if (this->err_ == json_errc{}) {
+            this->err_ = err;
+        }
+        return false;
+    }
+
+    void skip_ws_() noexcept {
+        while (this->pos_ < this->in_.size()) {
+            auto const chr = this->in_[this->pos_];
+            if (chr != ' ' && chr != '\t' && chr != '\n' && chr != '\r') {
+                return;
+            }
+            ++this->pos_;
+        }
+    }
+
+    /* skips whitespace, then consumes chr if it is the next character
+     */
+    [[nodiscard]]
+    bool consume_(char chr) noexcept {
+        this->skip_ws_();
+        if (this->pos_ < this->in_.size() && this->in_[this->pos_] == chr) {
+            ++this->pos_;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]]
+    bool expect_(char chr) noexcept {
+        if (this->consume_(chr)) {
+            return true;
+        }
+        return this->fail_(this->pos_ == this->in_.size() ? json_errc::unexpected_end : json_errc::syntax_error);
+    }
+
+    [[nodiscard]]
+    bool literal_(::std::string_view lit) noexcept {
+        if (this->in_.substr(this->pos_, lit.size()) != lit) {
+            return false;
+        }
+        this->pos_ += lit.size();
+        return true;
+    }
+
+    [[nodiscard]]
+    static bool hex4_(::std::string_view digits, ::std::uint32_t& res) noexcept {
+        if (digits.size() < 4) {
+            return false;
+        }
+        auto const conv = ::std::from_chars(digits.data(), digits.data() + 4, res, 16);
+        return conv.ec == ::std::errc{} && conv.ptr == digits.data() + 4;
+    }
+
+    /* raw contents of a string, escapes are checked but kept as is
+     */
+    [[nodiscard]]
+    bool raw_string_(::std::string_view& res) noexcept {
+        if (!this->expect_('"')) {
+            return false;
+        }
+        auto const begin = this->pos_;
+        while (this->pos_ < this->in_.size()) {
+            auto const chr = this->in_[this->pos_++];
+            if (chr == '"') {
+                res = this->in_.substr(begin, this->pos_ - begin - 1);
+                return true;
+            }
+            if (chr != '\\') {
+                continue;
+            }
+            if (this->pos_ == this->in_.size()) {
+                break;
+            }
+            auto const esc = this->in_[this->pos_++];
+            if (esc == 'u') {
+                ::std::uint32_t code{};
+                if (!json_reader_::hex4_(this->in_.substr(this->pos_), code)) {
+                    return this->fail_(json_errc::syntax_error);
+                }
+                this->pos_ += 4;
+            } else if (::std::string_view{"\"\\/bfnrt"}.find(esc) == ::std::string_view::npos) {
+                return this->fail_(json_errc::syntax_error);
+            }
+        }
+        return this->fail_(json_errc::unexpected_end);
+    }
+
+    template<typename Str>
+    [[nodiscard]]
+    bool string_(Str& res) noexcept {
+        ::std::string_view raw;
+        if (!this->raw_string_(raw)) {
+            return false;
+        }
+        res.clear();
+        for (::std::size_t i{}; i < raw.size(); ++i) {
+            if (raw[i] != '\\') {
+                res.push_back(raw[i]);
+                continue;
+            }
+            switch (raw[++i]) {
+            case 'b':
+                res.push_back('\b');
+                break;
+            case 'f':
+                res.push_back('\f');
+                break;
+            case 'n':
+                res.push_back('\n');
+                break;
+            case 'r':
+                res.push_back('\r');
+                break;
+            case 't':
+                res.push_back('\t');
+                break;
+            case 'u': {
+                ::std::uint32_t code{};
+                if (!json_reader_::hex4_(raw.substr(i + 1), code)) {
+                    return this->fail_(json_errc::syntax_error);
+                }
+                i += 4;
+                if (code >= 0xd800 && code <= 0xdbff) {
+                    ::std::uint32_t trail{};
+                    if (raw.substr(i + 1, 2) != "\\u" || !json_reader_::hex4_(raw.substr(i + 3), trail) ||
+                        trail < 0xdc00 || trail > 0xdfff) {
+                        return this->fail_(json_errc::syntax_error);
+                    }
+                    i += 6;
+                    code = 0x10000 + ((code - 0xd800) << 10) + (trail - 0xdc00);
+                }
+                if (code < 0x80) {
+                    res.push_back(static_cast<char>(code));
+                } else if (code < 0x800) {
+                    res.push_back(static_cast<char>((code >> 6) | 0xc0));
+                    res.push_back(static_cast<char>((code & 0x3f) | 0x80));
+                } else if (code < 0x10000) {
+                    res.push_back(static_cast<char>((code >> 12) | 0xe0));
+                    res.push_back(static_cast<char>(((code >> 6) & 0x3f) | 0x80));
+                    res.push_back(static_cast<char>((code & 0x3f) | 0x80));
+                } else {
+                    res.push_back(static_cast<char>((code >> 18) | 0xf0));
+                    res.push_back(static_cast<char>(((code >> 12) & 0x3f) | 0x80));
+                    res.push_back(static_cast<char>(((code >> 6) & 0x3f) | 0x80));
+                    res.push_back(static_cast<char>((code & 0x3f) | 0x80));
+                }
+                break;
+            }
+            default:
+                // '"', '\\' and '/', raw_string_ rejected any other escape
+                res.push_back(raw[i]);
+                break;
+            }
+        }
+        return true;
+    }
+
+    /* length of the JSON number at the start of str, 0 if there is none
+     *
+     * ::std::from_chars also takes inf, nan and leading zeros, which JSON does not.
+     */
+    [[nodiscard]]
+    static constexpr ::std::size_t number_length_(::std::string_view str) noexcept {
+        ::std::size_t i{};
+        auto const digits = [&] {
+            auto const start = i;
+            while (i < str.size() && str[i] >= '0' && str[i] <= '9') {
+                ++i;
+            }
+            return i - start;
+        };
+        if (i < str.size() && str[i] == '-') {
+            ++i;
+        }
+        if (i < str.size() && str[i] == '0') {
+            ++i;
+        } else if (digits() == 0) {
+            return 0;
+        }
+        if (i < str.size() && str[i] == '.') {
+            ++i;
+            if (digits() == 0) {
+                return 0;
+            }
+        }
+        if (i < str.size() && (str[i] == 'e' || str[i] == 'E')) {
+            ++i;
+            if (i < str.size() && (str[i] == '+' || str[i] == '-')) {
+                ++i;
+            }
+            if (digits() == 0) {
+                return 0;
+            }
+        }
+        return i;
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool number_(T& res) noexcept {
+        auto const* begin = this->in_.data() + this->pos_;
+        if constexpr (::std::is_floating_point_v<T>) {
+            if (this->literal_("null")) {
+                res = ::std::numeric_limits<T>::quiet_NaN();
+                return true;
+            }
+        }
+        auto const len = json_reader_::number_length_(this->in_.substr(this->pos_));
+        if (len == 0) {
+            return this->fail_(json_errc::type_mismatch);
+        }
+        auto const* end = begin + len;
+        auto const conv = ::std::from_chars(begin, end, res);
+        if (conv.ec == ::std::errc::result_out_of_range) {
+            return this->fail_(json_errc::out_of_range);
+        }
+        // a fraction or an exponent read into an integer
+        if (conv.ec != ::std::errc{} || conv.ptr != end) {
+            return this->fail_(json_errc::type_mismatch);
+        }
+        this->pos_ += static_cast<::std::size_t>(conv.ptr - begin);
+        return true;
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool value_(T& res) noexcept {
+        this->skip_ws_();
+        if (this->pos_ == this->in_.size()) {
+            return this->fail_(json_errc::unexpected_end);
+        }
+        if constexpr (::std::is_same_v<T, bool>) {
+            if (this->literal_("true")) {
+                res = true;
+                return true;
+            }
+            if (this->literal_("false")) {
+                res = false;
+                return true;
+            }
+            return this->fail_(json_errc::type_mismatch);
+        } else if constexpr (::std::is_arithmetic_v<T>) {
+            return this->number_(res);
+        } else if constexpr (is_namedtuple<T>) {
+            return this->object_(res);
+        } else if constexpr (requires(T& str) {
+                                 str.clear();
+                                 str.push_back('\0');
+                             }) {
+            if (this->in_[this->pos_] != '"') {
+                return this->fail_(json_errc::type_mismatch);
+            }
+            return this->string_(res);
+        } else {
+            static_assert(false && sizeof(T), "ctb::namedtuple::JsonError: unsupported field type");
+        }
+    }
+
+    /* nesting of arrays and objects skip_value_ follows before it gives up
+     */
+    static constexpr ::std::size_t max_skip_depth_{256};
+
+    /* skip the value of a key that is not a field
+     *
+     * The value is checked against the same grammar as fields: closers match
+     * their openers, literals are spelled out and numbers follow number_length_.
+     */
+    [[nodiscard]]
+    bool skip_value_(::std::size_t depth = 0) noexcept {
+        this->skip_ws_();
+        if (this->pos_ == this->in_.size()) {
+            return this->fail_(json_errc::unexpected_end);
+        }
+        auto const chr = this->in_[this->pos_];
+        if (chr == '"') {
+            ::std::string_view raw;
+            return this->raw_string_(raw);
+        }
+        if (chr == '{' || chr == '[') {
+            if (depth == max_skip_depth_) {
+                return this->fail_(json_errc::syntax_error);
+            }
+            ++this->pos_;
+            auto const closer = chr == '{' ? '}' : ']';
+            if (this->consume_(closer)) {
+                return true;
+            }
+            do {
+                if (chr == '{') {
+                    ::std::string_view key;
+                    if (!this->raw_string_(key) || !this->expect_(':')) {
+                        return false;
+                    }
+                }
+                if (!this->skip_value_(depth + 1)) {
+                    return false;
+                }
+            } while (this->consume_(','));
+            return this->expect_(closer);
+        }
+        if (this->literal_("true") || this->literal_("false") || this->literal_("null")) {
+            return true;
+        }
+        auto const len = json_reader_::number_length_(this->in_.substr(this->pos_));
+        if (len == 0) {
+            return this->fail_(json_errc::syntax_error);
+        }
+        this->pos_ += len;
+        return true;
+    }
+
+    template<typename NT>
+    [[nodiscard]]
+    bool object_(NT& nt) noexcept {
+        if (!this->expect_('{')) {
+            return false;
+        }
+        if (this->consume_('}')) {
+            return true;
+        }
+        do {
+            ::std::string_view key;
+            if (!this->raw_string_(key) || !this->expect_(':')) {
+                return false;
+            }
+            // keys with escapes never match a name, see is_json_name_
+            auto const found = ::ctb::namedtuple::visit_field(nt, key, [this](auto& field) {
+                return this->value_(field);
+            });
+            if (found.has_value() ? !found.value() : !this->skip_value_()) {
+                return false;
+            }
+        } while (this->consume_(','));
+        return this->expect_('}');
+    }
+};
+
+} // namespace details
+
+/* Parse a JSON object from in into nt
+ *
+ * Fields are written in place, fields that are absent from in keep their
+ * value and keys that are not fields are skipped.
+ * Returns the number of characters consumed.
+ */
+template<typename NT>
+    requires (is_namedtuple<NT>)
+[[nodiscard]]
+inline exception::expected<::std::size_t, json_errc> from_json(::std::string_view in, NT& nt) noexcept {
+    details::json_reader_ reader{in};
+    if (!reader.object_(nt)) {
+        return exception::unexpected{reader.err_};
+    }
+    return reader.pos_;
+}
+
+} // namespace ctb::namedtuple
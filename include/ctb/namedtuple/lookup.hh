@@ -0,0 +1,326 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../tuple/algorithm.hh"
+#include "../utils.hh"
+#include "../vector.hh"
+
+/* Runtime lookup of namedtuple fields by name
+ *
+ * The names of a namedtuple are known at compile time, so a perfect hash of
+ * them is built at compile time by hash and displace: a lookup hashes the
+ * runtime name once, reads its bucket and one slot and compares against one
+ * candidate name. If some bucket finds no displacement, which bounds the
+ * work, the lookup is a binary search over the sorted names instead.
+ *
+ * Usage: field_index<names<"id", "price">>(name)
+ *        visit_field(nt, name, [](auto& field) { ... });
+ */
+namespace ctb::namedtuple {
+
+namespace details {
+
+/* FNV-1a over the code units of a name
+ */
+template<typename Char>
+[[nodiscard]]
+constexpr ::std::uint64_t name_hash_(Char const* data, ::std::size_t size) noexcept {
+    ::std::uint64_t h{0xcbf29ce484222325u};
+    for (::std::size_t i{}; i < size; ++i) {
+        h ^= static_cast<::std::uint64_t>(static_cast<::std::make_unsigned_t<Char>>(data[i]));
+        h *= 0x100000001b3u;
+    }
+    return h ^ (h >> 32);
+}
+
+template<typename Char, string::string... Str>
+struct name_table_ {
+    static constexpr ::std::size_t size_{sizeof...(Str)};
+    static constexpr ::std::size_t slot_count_{::std::bit_ceil(size_ * 2 + 1)};
+    static constexpr ::std::size_t bucket_count_{::std::bit_ceil(size_ + 1)};
+    static constexpr auto npos_{static_cast<::std::size_t>(-1)};
+    /* displacements tried for one bucket before falling back to binary search
+     */
+    static constexpr ::std::uint64_t max_displacement_{1u << 12};
+    /* a displacement with this bit is the slot of the only name of its bucket
+     */
+    static constexpr ::std::uint64_t direct_{::std::uint64_t{1} << 63};
+
+    /* all names stored back to back, names whose code unit type is not
+     * Char never match and get the length npos_
+     */
+    struct layout_ {
+        ::ctb::vector::vector<Char, (Str.size() + ... + 1)> data_{};
+        ::ctb::vector::vector<::std::size_t, size_ + 1> offsets_{};
+        ::ctb::vector::vector<::std::size_t, size_ + 1> lengths_{};
+    };
+
+    [[nodiscard]]
+    static consteval layout_ make_layout_() noexcept {
+        layout_ res{};
+        ::std::size_t i{}, pos{};
+        auto append = [&](auto const& str) {
+            res.offsets_.arr[i] = pos;
+            if constexpr (::std::is_same_v<typename ::std::remove_cvref_t<decltype(str)>::value_type, Char>) {
+                for (auto chr : str) {
+                    res.data_.arr[pos++] = chr;
+                }
+                res.lengths_.arr[i] = str.size();
+            } else {
+                res.lengths_.arr[i] = npos_;
+            }
+            ++i;
+        };
+        (append(Str), ...);
+        res.lengths_.arr[size_] = npos_;
+        return res;
+    }
+
+    static constexpr layout_ layout_v_{name_table_::make_layout_()};
+
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash_(::std::size_t i) noexcept {
+        return details::name_hash_(layout_v_.data_.arr + layout_v_.offsets_.arr[i], layout_v_.lengths_.arr[i]);
+    }
+
+    /* slot of a name with hash h in a bucket displaced by displacement, splitmix64 finalizer
+     */
+    [[nodiscard]]
+    static constexpr ::std::size_t slot_(::std::uint64_t h, ::std::uint64_t displacement) noexcept {
+        auto x = h + displacement * 0x9e3779b97f4a7c15u;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9u;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebu;
+        return static_cast<::std::size_t>(x ^ (x >> 31)) & (slot_count_ - 1);
+    }
+
+    struct table_ {
+        ::ctb::vector::vector<::std::uint64_t, bucket_count_> displacements_{};
+        ::ctb::vector::vector<::std::size_t, slot_count_> slots_{};
+        bool perfect_{};
+    };
+
+    /* hash and displace: the names are split into buckets by their hash, then
+     * the buckets, largest first, each search a displacement that sends all
+     * their names to free slots. A bucket of one name takes any free slot.
+     */
+    [[nodiscard]]
+    static consteval table_ make_table_() noexcept {
+        table_ res{};
+        for (auto& slot : res.slots_.arr) {
+            slot = size_;
+        }
+        ::std::uint64_t hashes[size_ + 1]{};
+        ::std::size_t bucket_sizes[bucket_count_]{};
+        for (::std::size_t i{}; i < size_; ++i) {
+            if (layout_v_.lengths_.arr[i] != npos_) {
+                hashes[i] = name_table_::hash_(i);
+                ++bucket_sizes[hashes[i] & (bucket_count_ - 1)];
+            }
+        }
+        ::std::size_t order[bucket_count_]{};
+        for (::std::size_t b{}; b < bucket_count_; ++b) {
+            auto j = b;
+            for (; j > 0 && bucket_sizes[order[j - 1]] < bucket_sizes[b]; --j) {
+                order[j] = order[j - 1];
+            }
+            order[j] = b;
+        }
+
+        ::std::size_t next_free{};
+        for (auto const b : order) {
+            if (bucket_sizes[b] == 0) {
+                break;
+            }
+            auto const in_bucket = [&](::std::size_t i) {
+                return layout_v_.lengths_.arr[i] != npos_ && (hashes[i] & (bucket_count_ - 1)) == b;
+            };
+            if (bucket_sizes[b] == 1) {
+                while (res.slots_.arr[next_free] != size_) {
+                    ++next_free;
+                }
+                for (::std::size_t i{}; i < size_; ++i) {
+                    if (in_bucket(i)) {
+                        res.slots_.arr[next_free] = i;
+                    }
+                }
+                res.displacements_.arr[b] = direct_ | next_free;
+                continue;
+            }
+            bool placed{};
+            for (::std::uint64_t d{1}; d <= max_displacement_ && !placed; ++d) {
+                placed = true;
+                for (::std::size_t i{}; i < size_ && placed; ++i) {
+                    if (!in_bucket(i)) {
+                        continue;
+                    }
+                    auto const slot = name_table_::slot_(hashes[i], d);
+                    placed = res.slots_.arr[slot] == size_;
+                    // claimed, so a later name of the bucket on the same slot fails
+                    res.slots_.arr[slot] = placed ? i : res.slots_.arr[slot];
+                }
+                if (placed) {
+                    res.displacements_.arr[b] = d;
+                } else {
+                    for (::std::size_t i{}; i < size_; ++i) {
+                        if (in_bucket(i) && res.slots_.arr[name_table_::slot_(hashes[i], d)] == i) {
+                            res.slots_.arr[name_table_::slot_(hashes[i], d)] = size_;
+                        }
+                    }
+                }
+            }
+            if (!placed) {
+                return res;
+            }
+        }
+        res.perfect_ = true;
+        return res;
+    }
+
+    static constexpr table_ table_v_{name_table_::make_table_()};
+
+    /* compare the name i with name by length, then code units
+     */
+    [[nodiscard]]
+    static constexpr int compare_(::std::size_t i, ::std::basic_string_view<Char> name) noexcept {
+        if (layout_v_.lengths_.arr[i] != name.size()) {
+            return layout_v_.lengths_.arr[i] < name.size() ? -1 : 1;
+        }
+        auto const* data = layout_v_.data_.arr + layout_v_.offsets_.arr[i];
+        for (::std::size_t j{}; j < name.size(); ++j) {
+            if (data[j] != name[j]) {
+                return data[j] < name[j] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    /* the names of code unit type Char, ordered by compare_
+     */
+    struct sorted_names_ {
+        ::ctb::vector::vector<::std::size_t, size_ + 1> index_{};
+        ::std::size_t count_{};
+    };
+
+    [[nodiscard]]
+    static consteval sorted_names_ make_sorted_() noexcept {
+        sorted_names_ res{};
+        for (::std::size_t i{}; i < size_; ++i) {
+            auto const len = layout_v_.lengths_.arr[i];
+            if (len == npos_) {
+                continue;
+            }
+            auto const name = ::std::basic_string_view<Char>{layout_v_.data_.arr + layout_v_.offsets_.arr[i], len};
+            auto j = res.count_++;
+            for (; j > 0 && name_table_::compare_(res.index_.arr[j - 1], name) > 0; --j) {
+                res.index_.arr[j] = res.index_.arr[j - 1];
+            }
+            res.index_.arr[j] = i;
+        }
+        return res;
+    }
+
+    static constexpr sorted_names_ sorted_{name_table_::make_sorted_()};
+
+    /* binary search over sorted_, the lookup when no perfect hash was found
+     */
+    [[nodiscard]]
+    static constexpr ::std::size_t find_sorted_(::std::basic_string_view<Char> name) noexcept {
+        ::std::size_t lo{}, hi{sorted_.count_};
+        while (lo < hi) {
+            auto const mid = lo + (hi - lo) / 2;
+            auto const cmp = name_table_::compare_(sorted_.index_.arr[mid], name);
+            if (cmp == 0) {
+                return sorted_.index_.arr[mid];
+            }
+            if (cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return size_;
+    }
+
+    [[nodiscard]]
+    static constexpr ::std::size_t find_(::std::basic_string_view<Char> name) noexcept {
+        if constexpr (table_v_.perfect_) {
+            auto const h = details::name_hash_(name.data(), name.size());
+            auto const d = table_v_.displacements_.arr[h & (bucket_count_ - 1)];
+            auto const slot = (d & direct_) != 0 ? static_cast<::std::size_t>(d & ~direct_) : name_table_::slot_(h, d);
+            auto const i = table_v_.slots_.arr[slot];
+            return layout_v_.lengths_.arr[i] != npos_ && name_table_::compare_(i, name) == 0 ? i : size_;
+        } else {
+            return name_table_::find_sorted_(name);
+        }
+    }
+};
+
+template<typename Char, string::string... Str>
+[[nodiscard]]
+constexpr auto get_name_table_(names<Str...>) noexcept {
+    return ::ctb::utils::pass_type<name_table_<Char, Str...>>{};
+}
+
+} // namespace details
+
+/* index of the field called name, get_size<Names>() if there is not
+ *
+ * Usage: field_index<names<"a", "b">>("b") == 1
+ */
+template<details::is_names Names, string::is_char Char = char>
+[[nodiscard]]
+constexpr ::std::size_t field_index(::std::type_identity_t<::std::basic_string_view<Char>> name) noexcept {
+    using table_type = typename decltype(details::get_name_table_<Char>(Names{}))::type;
+    return table_type::find_(name);
+}
+
+/* Call visitor with the field I of nt, see ctb::tuple::visit_at
+ *
+ * Usage: visit_at(nt, column, [](auto& field) { ... });
+ */
+template<typename NT, typename Visitor>
+    requires (is_namedtuple<NT>)
+constexpr decltype(auto) visit_at(NT&& nt, ::std::size_t i, Visitor&& visitor) noexcept {
+    return ::ctb::tuple::visit_at(::std::forward<NT>(nt).tuple, i, ::std::forward<Visitor>(visitor));
+}
+
+/* Call visitor with the field called name
+ *
+ * Dispatch goes through visit_at with the index from field_index. If
+ * visitor returns void, the result tells whether the field exists,
+ * otherwise the result of visitor is returned as an optional.
+ */
+template<typename NT, typename Visitor>
+    requires (is_namedtuple<NT>)
+constexpr auto visit_field(NT&& nt, ::std::string_view name, Visitor&& visitor) noexcept {
+    using names_type = typename ::std::remove_cvref_t<NT>::names;
+    constexpr auto size = details::get_size<names_type>();
+    using result_type = ::ctb::tuple::details::visit_at_result_t_<decltype((::std::forward<NT>(nt).tuple)), Visitor&>;
+
+    auto const i = ::ctb::namedtuple::field_index<names_type>(name);
+    if constexpr (::std::is_void_v<result_type>) {
+        if (i == size) {
+            return false;
+        }
+        ::ctb::namedtuple::visit_at(::std::forward<NT>(nt), i, visitor);
+        return true;
+    } else {
+        if (i == size) {
+            return exception::optional<result_type>{exception::nullopt};
+        }
+        return exception::optional<result_type>{::ctb::namedtuple::visit_at(::std::forward<NT>(nt), i, visitor)};
+    }
+}
+
+} // namespace ctb::namedtuple
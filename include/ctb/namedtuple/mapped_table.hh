@@ -0,0 +1,433 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../utils.hh"
+#include "binary.hh"
+
+#ifdef _WIN32
+    // only for this include, the macros of the includer are left as they were
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #define CTB_N_UNDEF_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+        #define CTB_N_UNDEF_NOMINMAX
+    #endif
+    #include <windows.h>
+    #ifdef CTB_N_UNDEF_WIN32_LEAN_AND_MEAN
+        #undef WIN32_LEAN_AND_MEAN
+        #undef CTB_N_UNDEF_WIN32_LEAN_AND_MEAN
+    #endif
+    #ifdef CTB_N_UNDEF_NOMINMAX
+        #undef NOMINMAX
+        #undef CTB_N_UNDEF_NOMINMAX
+    #endif
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif // defined(_WIN32)
+
+/* Files of fixed-layout records described by a namedtuple schema
+ *
+ * A file is a 64 bytes header (magic, schema hash, row size, row count)
+ * followed by the rows in the wire format of ctb/namedtuple/binary.hh,
+ * without the per-row hash. mapped_table maps a file read-only and reads
+ * fields straight from the mapping, table_writer appends rows in large
+ * batches.
+ *
+ * Usage: auto table = mapped_table<trade>::open("trades.bin");
+ *        get<"price">(table.value()[i]);
+ */
+namespace ctb::namedtuple {
+
+enum class mapped_errc : unsigned char {
+    io_error = 1,
+    bad_header,
+    schema_mismatch,
+    truncated,
+    out_of_memory,
+};
+
+namespace details {
+
+inline constexpr char table_magic_[8]{'c', 't', 'b', 't', 'a', 'b', 'l', '\1'};
+
+struct table_header_ {
+    static constexpr ::std::size_t size_{64};
+
+    ::std::uint64_t schema_hash_{};
+    ::std::uint64_t row_size_{};
+    ::std::uint64_t row_count_{};
+
+    void write_(::std::byte* out) const noexcept {
+        using traits = ::ctb::tuple::details::wire_traits_<::std::uint64_t>;
+        ::std::memset(out, 0, size_);
+        ::std::memcpy(out, table_magic_, sizeof(table_magic_));
+        traits::write(this->schema_hash_, out + 8);
+        traits::write(this->row_size_, out + 16);
+        traits::write(this->row_count_, out + 24);
+    }
+
+    [[nodiscard]]
+    bool read_(::std::byte const* in) noexcept {
+        using traits = ::ctb::tuple::details::wire_traits_<::std::uint64_t>;
+        if (::std::memcmp(in, table_magic_, sizeof(table_magic_)) != 0) {
+            return false;
+        }
+        traits::read(in + 8, this->schema_hash_);
+        traits::read(in + 16, this->row_size_);
+        traits::read(in + 24, this->row_count_);
+        return true;
+    }
+};
+
+/* A read-only mapping of a whole file
+ */
+class mapped_file_ {
+    ::std::byte const* data_{};
+    ::std::size_t size_{};
+
+public:
+    constexpr mapped_file_() noexcept = default;
+
+    mapped_file_(mapped_file_ const&) = delete;
+    mapped_file_& operator=(mapped_file_ const&) = delete;
+
+    mapped_file_(mapped_file_&& other) noexcept
+        : data_{::std::exchange(other.data_, nullptr)},
+          size_{::std::exchange(other.size_, 0)} {
+    }
+
+    mapped_file_& operator=(mapped_file_&& other) noexcept {
+        if (this != &other) {
+            this->unmap_();
+            this->data_ = ::std::exchange(other.data_, nullptr);
+            this->size_ = ::std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file_() noexcept {
+        this->unmap_();
+    }
+
+    /* an empty file is mapped as size 0 with no data
+     */
+    [[nodiscard]]
+    bool map_(char const* path) noexcept {
+#ifdef _WIN32
+        auto const file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size)) {
+            ::CloseHandle(file);
+            return false;
+        }
+        this->size_ = static_cast<::std::size_t>(size.QuadPart);
+        if (this->size_ != 0) {
+            auto const mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                this->data_ = static_cast<::std::byte const*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                // the view keeps the mapping alive
+                ::CloseHandle(mapping);
+            }
+        }
+        ::CloseHandle(file);
+#else
+        auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            return false;
+        }
+        struct ::stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        this->size_ = static_cast<::std::size_t>(st.st_size);
+        if (this->size_ != 0) {
+            auto* const ptr = ::mmap(nullptr, this->size_, PROT_READ, MAP_SHARED, fd, 0);
+            this->data_ = ptr == MAP_FAILED ? nullptr : static_cast<::std::byte const*>(ptr);
+        }
+        // the mapping keeps the file alive
+        ::close(fd);
+#endif // defined(_WIN32)
+        if (this->size_ != 0 && this->data_ == nullptr) {
+            this->size_ = 0;
+            return false;
+        }
+        return true;
+    }
+
+    void unmap_() noexcept {
+        if (this->data_ == nullptr) {
+            return;
+        }
+#ifdef _WIN32
+        ::UnmapViewOfFile(this->data_);
+#else
+        ::munmap(const_cast<::std::byte*>(this->data_), this->size_);
+#endif // defined(_WIN32)
+        this->data_ = nullptr;
+        this->size_ = 0;
+    }
+
+    [[nodiscard]]
+    ::std::byte const* data() const noexcept {
+        return this->data_;
+    }
+
+    [[nodiscard]]
+    ::std::size_t size() const noexcept {
+        return this->size_;
+    }
+};
+
+} // namespace details
+
+template<typename Schema>
+class mapped_row;
+
+/* One row of a mapped_table, fields are read from the mapping on access
+ */
+template<details::is_names Names, typename... Args>
+class mapped_row<namedtuple<Names, Args...>> {
+    ::std::byte const* data_;
+
+public:
+    using schema = namedtuple<Names, Args...>;
+    using names = Names;
+
+    explicit constexpr mapped_row(::std::byte const* data) noexcept
+        : data_{data} {
+    }
+
+    template<::std::size_t I>
+    [[nodiscard]]
+    auto field() const noexcept {
+        using T = ::ctb::utils::pack_indexing_t<I, Args...>;
+        constexpr auto offset = ::ctb::tuple::details::wire_offset_<I, Args...>;
+        T res{};
+        ::ctb::tuple::details::wire_traits_<T>::read(this->data_ + offset, res);
+        return res;
+    }
+
+    /* copy the whole row out of the mapping
+     */
+    [[nodiscard]]
+    schema load() const noexcept {
+        schema res{};
+        ::ctb::tuple::details::wire_traits_<schema>::read(this->data_, res);
+        return res;
+    }
+};
+
+/* get mapped_row field by name
+ *
+ * Usage: get<"name">(table[i])
+ */
+template<string::string str, typename Schema>
+[[nodiscard]]
+auto get(mapped_row<Schema> row) noexcept {
+    using names_type = typename mapped_row<Schema>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return row.template field<index>();
+}
+
+template<::std::size_t N, typename Schema>
+[[nodiscard]]
+auto get(mapped_row<Schema> row) noexcept {
+    return row.template field<N>();
+}
+
+/* A read-only memory-mapped file of Schema rows, Schema has at least one byte on the wire
+ */
+template<typename Schema>
+    requires (is_namedtuple<Schema> && ::ctb::tuple::details::is_wire_type_<Schema> &&
+              ::ctb::tuple::details::wire_traits_<Schema>::size != 0)
+class mapped_table {
+    static constexpr ::std::size_t row_size_{::ctb::tuple::details::wire_traits_<Schema>::size};
+
+    details::mapped_file_ file_;
+    ::std::size_t size_{};
+
+    mapped_table(details::mapped_file_&& file, ::std::size_t size) noexcept
+        : file_{::std::move(file)},
+          size_{size} {
+    }
+
+public:
+    using schema = Schema;
+
+    mapped_table(mapped_table&&) noexcept = default;
+    mapped_table& operator=(mapped_table&&) noexcept = default;
+
+    /* Map path and check its header against Schema once
+     */
+    [[nodiscard]]
+    static exception::expected<mapped_table, mapped_errc> open(char const* path) noexcept {
+        details::mapped_file_ file{};
+        if (!file.map_(path)) {
+            return exception::unexpected{mapped_errc::io_error};
+        }
+        details::table_header_ header{};
+        if (file.size() < details::table_header_::size_ || !header.read_(file.data())) {
+            return exception::unexpected{mapped_errc::bad_header};
+        }
+        if (header.schema_hash_ != ::ctb::tuple::schema_hash<Schema> || header.row_size_ != row_size_) {
+            return exception::unexpected{mapped_errc::schema_mismatch};
+        }
+        if ((file.size() - details::table_header_::size_) / row_size_ < header.row_count_) {
+            return exception::unexpected{mapped_errc::truncated};
+        }
+        return mapped_table{::std::move(file), static_cast<::std::size_t>(header.row_count_)};
+    }
+
+    [[nodiscard]]
+    mapped_row<Schema> operator[](::std::size_t i) const noexcept {
+        exception::assert_true(i < this->size_);
+        return mapped_row<Schema>{this->file_.data() + details::table_header_::size_ + i * row_size_};
+    }
+
+    [[nodiscard]]
+    ::std::size_t size() const noexcept {
+        return this->size_;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return this->size_ == 0;
+    }
+};
+
+/* Appends Schema rows to a file readable by mapped_table
+ *
+ * Rows are encoded into a heap buffer of BatchBytes, allocated once by
+ * create() and owned by the writer, which is written
+ * whole, so every write but the last one is BatchBytes long and at a
+ * multiple of BatchBytes in the file. close() writes the final row count.
+ */
+template<typename Schema, ::std::size_t BatchBytes = ::std::size_t{1} << 16>
+    requires (is_namedtuple<Schema> && ::ctb::tuple::details::is_wire_type_<Schema> &&
+              ::ctb::tuple::details::wire_traits_<Schema>::size != 0 &&
+              BatchBytes >= details::table_header_::size_ && BatchBytes % 4096 == 0)
+class table_writer {
+    static constexpr ::std::size_t row_size_{::ctb::tuple::details::wire_traits_<Schema>::size};
+
+    ::std::FILE* file_{};
+    ::std::size_t len_{};
+    ::std::uint64_t rows_{};
+    ::std::unique_ptr<::std::byte[]> buf_;
+
+    table_writer(::std::FILE* file, ::std::unique_ptr<::std::byte[]> buf) noexcept
+        : file_{file},
+          len_{details::table_header_::size_},
+          buf_{::std::move(buf)} {
+        // the header is written again by close()
+        details::table_header_{::ctb::tuple::schema_hash<Schema>, row_size_, 0}.write_(this->buf_.get());
+    }
+
+    [[nodiscard]]
+    bool flush_() noexcept {
+        auto const ok = ::std::fwrite(this->buf_.get(), 1, this->len_, this->file_) == this->len_;
+        this->len_ = 0;
+        return ok;
+    }
+
+public:
+    using schema = Schema;
+
+    table_writer(table_writer const&) = delete;
+    table_writer& operator=(table_writer const&) = delete;
+
+    table_writer(table_writer&& other) noexcept
+        : file_{::std::exchange(other.file_, nullptr)},
+          len_{other.len_},
+          rows_{other.rows_},
+          buf_{::std::move(other.buf_)} {
+    }
+
+    ~table_writer() noexcept {
+        static_cast<void>(this->close());
+    }
+
+    /* Create or truncate path
+     */
+    [[nodiscard]]
+    static exception::expected<table_writer, mapped_errc> create(char const* path) noexcept {
+        ::std::unique_ptr<::std::byte[]> buf{::new (::std::nothrow) ::std::byte[BatchBytes]};
+        if (buf == nullptr) [[unlikely]] {
+            return exception::unexpected{mapped_errc::out_of_memory};
+        }
+        auto* file = ::std::fopen(path, "wb");
+        if (file == nullptr) {
+            return exception::unexpected{mapped_errc::io_error};
+        }
+        // writes go through buf_ already
+        ::std::setvbuf(file, nullptr, _IONBF, 0);
+        return table_writer{file, ::std::move(buf)};
+    }
+
+    /* false on I/O error
+     */
+    [[nodiscard]]
+    bool append(Schema const& row) noexcept {
+        ::std::byte bytes[row_size_];
+        ::ctb::tuple::details::wire_traits_<Schema>::write(row, bytes);
+        ::std::size_t done{};
+        while (done != row_size_) {
+            auto const n = ::std::min(row_size_ - done, BatchBytes - this->len_);
+            ::std::memcpy(this->buf_.get() + this->len_, bytes + done, n);
+            this->len_ += n;
+            done += n;
+            if (this->len_ == BatchBytes && !this->flush_()) [[unlikely]] {
+                return false;
+            }
+        }
+        ++this->rows_;
+        return true;
+    }
+
+    /* Write the pending rows and the header, false on I/O error
+     */
+    [[nodiscard]]
+    bool close() noexcept {
+        if (this->file_ == nullptr) {
+            return true;
+        }
+        auto ok = this->flush_();
+        ::std::byte header[details::table_header_::size_];
+        details::table_header_{::ctb::tuple::schema_hash<Schema>, row_size_, this->rows_}.write_(header);
+        ok = ok && ::std::fseek(this->file_, 0, SEEK_SET) == 0 &&
+             ::std::fwrite(header, 1, sizeof(header), this->file_) == sizeof(header);
+        ok = ::std::fclose(::std::exchange(this->file_, nullptr)) == 0 && ok;
+        return ok;
+    }
+
+    [[nodiscard]]
+    ::std::uint64_t size() const noexcept {
+        return this->rows_;
+    }
+};
+
+} // namespace ctb::namedtuple
@@ -0,0 +1,248 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../vector.hh"
+
+/* Bit-packed records with a width per field
+ *
+ * Fields are laid out one after another in 64-bit words, a field that does
+ * not fit in the rest of a word starts the next one, so reading or writing
+ * a field is one shift and one mask on one word. Fields never straddle two
+ * words, which trades space for that: fields<{"a", 40}, {"b", 30}, {"c", 64},
+ * {"d", 1}> has 135 bits but takes 4 words, not 3. Order fields so that
+ * narrow ones fill the tail of a word to avoid the gaps.
+ *
+ * Usage: using state = packed_namedtuple<fields<{"flags", 3}, {"kind", 5}, {"len", 24}>>;
+ *        set<"kind">(s, 7);
+ *        get<"kind">(s) == 7;
+ */
+namespace ctb::namedtuple {
+
+/* name and width in bits of a field of packed_namedtuple
+ */
+template<string::is_char Char, ::std::size_t N>
+struct field {
+    string::string<Char, N> name;
+    ::std::size_t bits;
+
+    constexpr field(Char const (&name_)[N], ::std::size_t bits_) noexcept
+        : name{name_},
+          bits{bits_} {
+    }
+};
+
+template<field... F>
+struct fields {
+    static_assert(((F.bits > 0 && F.bits <= 64) && ...),
+                  "ctb::namedtuple::PackError: field width must be in [1, 64]");
+
+    using names = ::ctb::namedtuple::names<F.name...>;
+    static constexpr ::std::size_t size{sizeof...(F)};
+    static constexpr ::std::size_t bits[size + 1]{F.bits..., 0};
+};
+
+namespace details {
+
+template<typename>
+constexpr bool is_fields_ = false;
+
+template<field... F>
+constexpr bool is_fields_<fields<F...>> = true;
+
+template<typename T>
+concept is_fields = is_fields_<T>;
+
+/* position of every field, and the number of words
+ */
+template<is_fields Fields>
+struct packed_layout_ {
+    struct slot_ {
+        ::std::size_t word_;
+        ::std::size_t shift_;
+    };
+
+    [[nodiscard]]
+    static consteval auto make_slots_() noexcept {
+        ::ctb::vector::vector<slot_, Fields::size + 1> res{};
+        ::std::size_t offset{};
+        for (::std::size_t i{}; i < Fields::size; ++i) {
+            if (offset % 64 + Fields::bits[i] > 64) {
+                offset += 64 - offset % 64;
+            }
+            res.arr[i] = slot_{offset / 64, offset % 64};
+            offset += Fields::bits[i];
+        }
+        res.arr[Fields::size] = slot_{(offset + 63) / 64, 0};
+        return res;
+    }
+
+    static constexpr auto slots_{packed_layout_::make_slots_()};
+    static constexpr ::std::size_t word_count_{slots_.arr[Fields::size].word_};
+};
+
+/* smallest unsigned type holding bits bits
+ */
+template<::std::size_t bits>
+using packed_value_type_ =
+    ::std::conditional_t<bits <= 8, ::std::uint8_t,
+                         ::std::conditional_t<bits <= 16, ::std::uint16_t,
+                                              ::std::conditional_t<bits <= 32, ::std::uint32_t, ::std::uint64_t>>>;
+
+} // namespace details
+
+template<details::is_fields Fields>
+struct packed_namedtuple {
+    using fields = Fields;
+    using names = typename Fields::names;
+
+    ::ctb::vector::vector<::std::uint64_t, ::std::max<::std::size_t>(details::packed_layout_<Fields>::word_count_, 1)>
+        words{};
+
+    /* word, shift, mask and value type of the I-th field
+     */
+    template<::std::size_t I>
+    struct slot {
+        static_assert(I < Fields::size, "ctb::namedtuple::IndexError: index out of range");
+
+        static constexpr auto word{details::packed_layout_<Fields>::slots_.arr[I].word_};
+        static constexpr auto shift{details::packed_layout_<Fields>::slots_.arr[I].shift_};
+        static constexpr ::std::uint64_t mask{Fields::bits[I] == 64 ? ~::std::uint64_t{}
+                                                                     : (::std::uint64_t{1} << Fields::bits[I]) - 1};
+        using value_type = details::packed_value_type_<Fields::bits[I]>;
+    };
+
+    [[nodiscard]]
+    constexpr bool operator==(packed_namedtuple const&) const noexcept = default;
+};
+
+namespace details {
+
+template<typename>
+constexpr bool is_packed_namedtuple_ = false;
+
+template<typename Fields>
+constexpr bool is_packed_namedtuple_<packed_namedtuple<Fields>> = true;
+
+template<string::string str, typename Packed>
+[[nodiscard]]
+consteval ::std::size_t packed_index_() noexcept {
+    using names_type = typename Packed::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return index;
+}
+
+} // namespace details
+
+template<typename T>
+concept is_packed_namedtuple = details::is_packed_namedtuple_<::std::remove_cvref_t<T>>;
+
+/* get packed_namedtuple field by index
+ *
+ * Usage: get<1>(p)
+ */
+template<::std::size_t I, typename Fields>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto get(packed_namedtuple<Fields> const& p) noexcept {
+    using slot = typename packed_namedtuple<Fields>::template slot<I>;
+    return static_cast<typename slot::value_type>((p.words.arr[slot::word] >> slot::shift) & slot::mask);
+}
+
+/* get packed_namedtuple field by name
+ *
+ * Usage: get<"name">(p)
+ */
+template<string::string str, typename Fields>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto get(packed_namedtuple<Fields> const& p) noexcept {
+    return ::ctb::namedtuple::get<details::packed_index_<str, packed_namedtuple<Fields>>()>(p);
+}
+
+/* set packed_namedtuple field by index, val must fit in the field
+ */
+template<::std::size_t I, typename Fields>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+constexpr void set(packed_namedtuple<Fields>& p, ::std::uint64_t val) noexcept {
+    using slot = typename packed_namedtuple<Fields>::template slot<I>;
+    exception::assert_true((val & ~slot::mask) == 0);
+    auto& word = p.words.arr[slot::word];
+    word = (word & ~(slot::mask << slot::shift)) | (val << slot::shift);
+}
+
+/* set packed_namedtuple field by name
+ *
+ * Usage: set<"name">(p, 1)
+ */
+template<string::string str, typename Fields>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+constexpr void set(packed_namedtuple<Fields>& p, ::std::uint64_t val) noexcept {
+    ::ctb::namedtuple::set<details::packed_index_<str, packed_namedtuple<Fields>>()>(p, val);
+}
+
+/* Copy the field str of every record of in into out
+ *
+ * No branch in the loop, so it vectorizes.
+ */
+template<string::string str, ::std::ranges::contiguous_range In, ::std::ranges::contiguous_range Out>
+    requires (is_packed_namedtuple<::std::ranges::range_value_t<In>>)
+constexpr void unpack(In const& in, Out&& out) noexcept {
+    using packed_type = ::std::ranges::range_value_t<In>;
+    using value_type = ::std::ranges::range_value_t<Out>;
+    constexpr auto index = details::packed_index_<str, packed_type>();
+    auto const size = ::std::ranges::size(in);
+    exception::assert_true(::std::ranges::size(out) >= size);
+    auto const* src = ::std::ranges::data(in);
+    auto* dst = ::std::ranges::data(out);
+    for (::std::size_t i{}; i < size; ++i) {
+        dst[i] = static_cast<value_type>(::ctb::namedtuple::get<index>(src[i]));
+    }
+}
+
+/* Write in[i] into the field str of records[i], values are truncated to
+ * the width of the field
+ */
+template<string::string str, ::std::ranges::contiguous_range Records, ::std::ranges::contiguous_range In>
+    requires (is_packed_namedtuple<::std::ranges::range_value_t<Records>>)
+constexpr void pack(Records&& records, In const& in) noexcept {
+    using packed_type = ::std::ranges::range_value_t<Records>;
+    using slot = typename packed_type::template slot<details::packed_index_<str, packed_type>()>;
+    auto const size = ::std::ranges::size(records);
+    exception::assert_true(::std::ranges::size(in) >= size);
+    auto* dst = ::std::ranges::data(records);
+    auto const* src = ::std::ranges::data(in);
+    for (::std::size_t i{}; i < size; ++i) {
+        auto& word = dst[i].words.arr[slot::word];
+        auto const val = static_cast<::std::uint64_t>(src[i]) & slot::mask;
+        word = (word & ~(slot::mask << slot::shift)) | (val << slot::shift);
+    }
+}
+
+} // namespace ctb::namedtuple
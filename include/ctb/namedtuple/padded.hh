@@ -0,0 +1,100 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../namedtuple.hh"
+#include "../tuple/padded.hh"
+
+/* A namedtuple with chosen fields alone on their cache line, see ctb/tuple/padded.hh
+ *
+ * Usage: using stats = padded_namedtuple<names<"hits", "misses", "id">,
+ *                                        isolated<std::uint64_t>, isolated<std::uint64_t>, int>;
+ *        stats s{};
+ *        ++get<"hits">(s);
+ */
+namespace ctb::namedtuple {
+
+using ::ctb::tuple::isolated;
+
+template<details::is_names Names, typename... Args>
+    requires (details::get_size<Names>() == sizeof...(Args))
+struct padded_namedtuple {
+    using names = Names;
+    tuple::padded_tuple<Args...> tuple;
+
+    constexpr padded_namedtuple() noexcept = default;
+
+    /* fields in declaration order, narrowing arguments are rejected as in brace initialization
+     */
+    template<typename... Ts>
+        requires (sizeof...(Ts) == sizeof...(Args) &&
+                  (tuple::details::is_brace_constructible_<tuple::details::unwrap_isolated_t_<Args>, Ts&&> && ...))
+    constexpr padded_namedtuple(Ts&&... args) noexcept
+        : tuple{::std::forward<Ts>(args)...} {
+    }
+};
+
+namespace details {
+
+template<typename T>
+constexpr bool is_padded_namedtuple_ = false;
+
+template<is_names Names, typename... Args>
+constexpr bool is_padded_namedtuple_<padded_namedtuple<Names, Args...>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_padded_namedtuple = details::is_padded_namedtuple_<::std::remove_cvref_t<T>>;
+
+/* get padded_namedtuple field by name
+ *
+ * Usage: get<"name">(nt)
+ */
+template<string::string str, is_padded_namedtuple NT>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(NT&& nt) noexcept {
+    using names_type = typename ::std::remove_cvref_t<NT>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return tuple::get<index>(::std::forward<NT>(nt).tuple);
+}
+
+/* get padded_namedtuple field by index
+ *
+ * Usage: get<1>(nt)
+ */
+template<::std::size_t N, is_padded_namedtuple NT>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(NT&& nt) noexcept {
+    return tuple::get<N>(::std::forward<NT>(nt).tuple);
+}
+
+} // namespace ctb::namedtuple
+
+/* C++17 structured binding support
+ */
+template<::ctb::namedtuple::details::is_names Names, typename... Args>
+struct std::tuple_size<::ctb::namedtuple::padded_namedtuple<Names, Args...>>
+    : public ::std::integral_constant<::std::size_t, sizeof...(Args)> {};
+
+template<::std::size_t N, ::ctb::namedtuple::details::is_names Names, typename... Args>
+struct std::tuple_element<N, ::ctb::namedtuple::padded_namedtuple<Names, Args...>> {
+    using type = ::std::tuple_element_t<N, ::ctb::tuple::padded_tuple<Args...>>;
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "../vector/bitset.hh"
+#include "../vector/hash_map.hh"
+#include "soa_vector.hh"
+
+/* Query operators over soa_vector tables
+ *
+ * Fields are selected by name at compile time, so a query can not drift
+ * out of sync with the schema.
+ *
+ * Usage: auto sel = filter<"qty">(table, [](auto qty) { return qty > 10; });
+ *        auto sums = group_by<"sym">(table, sel).sum<"price">();
+ */
+namespace ctb::namedtuple {
+
+namespace details {
+
+template<string::string str, typename Table>
+[[nodiscard]]
+consteval ::std::size_t field_index_() noexcept {
+    using names_type = typename ::std::remove_cvref_t<Table>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return index;
+}
+
+/* capacity of a hash map that holds one entry per row at no more than half load
+ */
+template<::std::size_t Cap>
+inline constexpr ::std::size_t group_capacity_{::std::bit_ceil(::std::max<::std::size_t>(2 * Cap, 16))};
+
+/* bytes of scratch a query keeps on the stack, the per-group hash map and the join chains
+ */
+inline constexpr ::std::size_t stack_bound_{::std::size_t{1} << 20};
+
+} // namespace details
+
+/* Rows of table whose field str satisfies pred, as a bitset selection
+ *
+ * Rows are processed in batches of 64: every batch evaluates pred without
+ * branching and packs the results into one word, which compilers vectorize.
+ */
+template<string::string str, typename Schema, ::std::size_t Cap, typename Pred>
+[[nodiscard]]
+constexpr auto filter(soa_vector<Schema, Cap> const& table, Pred const& pred) noexcept {
+    auto const col = table.template column<details::field_index_<str, soa_vector<Schema, Cap>>()>();
+    using word_type = typename ::ctb::vector::bitset<Cap>::word_type;
+    constexpr auto word_bits = ::ctb::vector::bitset<Cap>::word_bits;
+
+    ::ctb::vector::bitset<Cap> res{};
+    auto const full_words = col.size() / word_bits;
+    for (::std::size_t w{}; w < full_words; ++w) {
+        word_type word{};
+        for (::std::size_t i{}; i < word_bits; ++i) {
+            word |= static_cast<word_type>(static_cast<bool>(pred(col[w * word_bits + i]))) << i;
+        }
+        res.words.arr[w] = word;
+    }
+    for (auto i = full_words * word_bits; i < col.size(); ++i) {
+        res.words.arr[full_words] |= static_cast<word_type>(static_cast<bool>(pred(col[i]))) << (i % word_bits);
+    }
+    return res;
+}
+
+/* Refine an existing selection
+ */
+template<string::string str, typename Schema, ::std::size_t Cap, typename Pred>
+[[nodiscard]]
+constexpr auto filter(soa_vector<Schema, Cap> const& table, Pred const& pred,
+                      ::ctb::vector::bitset<Cap> const& selection) noexcept {
+    return ::ctb::namedtuple::filter<str>(table, pred) & selection;
+}
+
+namespace details {
+
+template<typename Schema, ::std::size_t Cap>
+[[nodiscard]]
+constexpr auto all_rows_of_(soa_vector<Schema, Cap> const& table) noexcept {
+    ::ctb::vector::bitset<Cap> res{};
+    for (::std::size_t i{}; i < table.size(); ++i) {
+        res.set(i);
+    }
+    return res;
+}
+
+} // namespace details
+
+/* Aggregations of the selected rows grouped by the field str
+ *
+ * Results are inline_hash_map keyed by the group field, so group fields must be
+ * hashable by ::ctb::vector::hash (integers and enums) or by Hash. The map has
+ * room for 2 * Cap groups and is returned by value, its size is checked against
+ * details::stack_bound_ at compile time. grouped refers to the table, which must
+ * outlive it; group_by on a temporary table does not compile.
+ */
+template<string::string str, typename Table, typename Hash>
+class grouped {
+    static constexpr auto key_index_ = details::field_index_<str, Table>();
+    static constexpr auto cap_ = Table::capacity();
+
+    Table const& table_;
+    ::ctb::vector::bitset<cap_> selection_;
+
+    template<typename Acc, typename F>
+    [[nodiscard]]
+    constexpr auto aggregate_(F&& f) const noexcept {
+        using key_type = typename decltype(this->table_.template column<key_index_>())::value_type;
+        using map_type =
+            ::ctb::vector::inline_hash_map<::std::remove_cv_t<key_type>, Acc, details::group_capacity_<cap_>, Hash>;
+        static_assert(sizeof(map_type) <= details::stack_bound_,
+                      "ctb::namedtuple::CapacityError: group_by result exceeds the stack bound, use a smaller table");
+        map_type res{};
+        auto const keys = this->table_.template column<key_index_>();
+        for (auto row : this->selection_) {
+            // one entry per row at most, never more than half full
+            f(*res.try_emplace(keys[row], Acc{}), row);
+        }
+        return res;
+    }
+
+public:
+    constexpr grouped(Table const& table, ::ctb::vector::bitset<cap_> const& selection) noexcept
+        : table_{table},
+          selection_{selection} {
+    }
+
+    grouped(Table const&&, ::ctb::vector::bitset<cap_> const&) = delete;
+
+    template<string::string field>
+    [[nodiscard]]
+    constexpr auto sum() const noexcept {
+        auto const values = this->table_.template column<details::field_index_<field, Table>()>();
+        using value_type = ::std::remove_cv_t<typename decltype(values)::value_type>;
+        return this->template aggregate_<value_type>([&](value_type& acc, ::std::size_t row) {
+            acc += values[row];
+        });
+    }
+
+    [[nodiscard]]
+    constexpr auto count() const noexcept {
+        return this->template aggregate_<::std::size_t>([](::std::size_t& acc, ::std::size_t) {
+            ++acc;
+        });
+    }
+};
+
+template<string::string str, typename Hash = void, typename Schema, ::std::size_t Cap>
+[[nodiscard]]
+constexpr auto group_by(soa_vector<Schema, Cap> const& table, ::ctb::vector::bitset<Cap> const& selection) noexcept {
+    using table_type = soa_vector<Schema, Cap>;
+    using key_type = typename decltype(table.template column<details::field_index_<str, table_type>()>())::value_type;
+    using hash_type =
+        ::std::conditional_t<::std::is_void_v<Hash>, ::ctb::vector::hash<::std::remove_cv_t<key_type>>, Hash>;
+    return grouped<str, table_type, hash_type>{table, selection};
+}
+
+template<string::string str, typename Hash = void, typename Schema, ::std::size_t Cap>
+[[nodiscard]]
+constexpr auto group_by(soa_vector<Schema, Cap> const& table) noexcept {
+    return ::ctb::namedtuple::group_by<str, Hash>(table, details::all_rows_of_(table));
+}
+
+template<string::string str, typename Hash = void, typename Schema, ::std::size_t Cap>
+void group_by(soa_vector<Schema, Cap> const&&, ::ctb::vector::bitset<Cap> const&) = delete;
+
+template<string::string str, typename Hash = void, typename Schema, ::std::size_t Cap>
+void group_by(soa_vector<Schema, Cap> const&&) = delete;
+
+/* Equi-join of two tables on the field str, calls f(row_of_lhs, row_of_rhs)
+ * for each matching pair.
+ *
+ * rhs is the build side: an inline hash map from key to the first row of rhs with
+ * that key, rows with the same key are chained in an inline array. Both live on
+ * the stack, the map at no more than half load, and their size is checked against
+ * details::stack_bound_ at compile time.
+ */
+template<string::string str, typename Hash = void, typename Schema, ::std::size_t Cap, typename Schema_r,
+         ::std::size_t Cap_r, typename F>
+constexpr void hash_join(soa_vector<Schema, Cap> const& lhs, soa_vector<Schema_r, Cap_r> const& rhs, F&& f) noexcept {
+    auto const lhs_keys = lhs.template column<details::field_index_<str, soa_vector<Schema, Cap>>()>();
+    auto const rhs_keys = rhs.template column<details::field_index_<str, soa_vector<Schema_r, Cap_r>>()>();
+    using key_type = ::std::remove_cv_t<typename decltype(rhs_keys)::value_type>;
+    using hash_type = ::std::conditional_t<::std::is_void_v<Hash>, ::ctb::vector::hash<key_type>, Hash>;
+    using map_type =
+        ::ctb::vector::inline_hash_map<key_type, ::std::size_t, details::group_capacity_<Cap_r>, hash_type>;
+    using next_type = ::ctb::vector::vector<::std::size_t, Cap_r>;
+    static_assert(sizeof(map_type) + sizeof(next_type) <= details::stack_bound_,
+                  "ctb::namedtuple::CapacityError: hash_join build side exceeds the stack bound, use a smaller rhs");
+    constexpr auto npos = Cap_r;
+
+    map_type heads{};
+    next_type next{};
+    // built backward so that chains are in row order
+    for (auto i = rhs_keys.size(); i-- > 0;) {
+        auto* head = heads.try_emplace(rhs_keys[i], npos);
+        next.arr[i] = *head;
+        *head = i;
+    }
+
+    for (::std::size_t i{}; i < lhs_keys.size(); ++i) {
+        auto const* head = heads.find(lhs_keys[i]);
+        if (head == nullptr) {
+            continue;
+        }
+        for (auto j = *head; j != npos; j = next.arr[j]) {
+            f(lhs[i], rhs[j]);
+        }
+    }
+}
+
+} // namespace ctb::namedtuple
@@ -0,0 +1,227 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../utils.hh"
+#include "../vector.hh"
+
+namespace ctb::namedtuple {
+
+namespace details {
+
+template<::std::size_t I, typename T, ::std::size_t Cap>
+struct alignas(::ctb::utils::cache_line_size) soa_column_ {
+    ::ctb::vector::vector<T, Cap> data_{};
+};
+
+template<::std::size_t Cap, typename... Args, ::std::size_t... Index>
+    requires (sizeof...(Args) == sizeof...(Index))
+[[nodiscard]]
+constexpr auto get_soa_columns_(::std::index_sequence<Index...>) noexcept {
+    struct soa_columns_ : soa_column_<Index, Args, Cap>... {};
+
+    return ::ctb::utils::pass_type<soa_columns_>();
+}
+
+} // namespace details
+
+template<typename Table>
+class soa_row;
+
+/* A table of Cap rows stored column by column (structure of arrays)
+ *
+ * Schema is a namedtuple type, every field is stored in its own contiguous
+ * and cache-line aligned column, so scanning one field only touches that column.
+ *
+ * Usage: soa_vector<namedtuple<names<"id", "price">, int, double>, 1024>
+ */
+template<typename Schema, ::std::size_t Cap>
+class soa_vector;
+
+template<details::is_names Names, typename... Args, ::std::size_t Cap>
+    requires (Cap > 0)
+class soa_vector<namedtuple<Names, Args...>, Cap> {
+    using columns_type_ = typename decltype(::ctb::namedtuple::details::get_soa_columns_<Cap, Args...>(
+        ::std::make_index_sequence<sizeof...(Args)>{}))::type;
+
+    columns_type_ columns_{};
+    ::std::size_t size_{};
+
+    template<::std::size_t I>
+    using column_type_ = details::soa_column_<I, ::ctb::utils::pack_indexing_t<I, Args...>, Cap>;
+
+public:
+    using schema = namedtuple<Names, Args...>;
+    using names = Names;
+
+    constexpr soa_vector() noexcept = default;
+    constexpr ~soa_vector() noexcept = default;
+
+    /* false if the table is full
+     */
+    template<typename... U>
+        requires (sizeof...(U) == sizeof...(Args))
+    constexpr bool emplace_back(U&&... vals) noexcept {
+        if (this->size_ == Cap) [[unlikely]] {
+            return false;
+        }
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            ((static_cast<column_type_<I>&>(this->columns_).data_.arr[this->size_] = ::std::forward<U>(vals)), ...);
+        }(::std::make_index_sequence<sizeof...(Args)>{});
+        ++this->size_;
+        return true;
+    }
+
+    constexpr bool push_back(schema const& row) noexcept {
+        return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            return this->emplace_back(::ctb::tuple::get<I>(row.tuple)...);
+        }(::std::make_index_sequence<sizeof...(Args)>{});
+    }
+
+    constexpr void pop_back() noexcept {
+        exception::assert_true(this->size_ > 0);
+        --this->size_;
+    }
+
+    constexpr void clear() noexcept {
+        this->size_ = 0;
+    }
+
+    /* Contiguous values of the I-th field of all rows
+     */
+    template<::std::size_t I>
+    [[nodiscard]]
+    constexpr auto column() noexcept {
+        using T = ::ctb::utils::pack_indexing_t<I, Args...>;
+        return ::std::span<T>{static_cast<column_type_<I>&>(this->columns_).data_.arr, this->size_};
+    }
+
+    template<::std::size_t I>
+    [[nodiscard]]
+    constexpr auto column() const noexcept {
+        using T = ::ctb::utils::pack_indexing_t<I, Args...>;
+        return ::std::span<T const>{static_cast<column_type_<I> const&>(this->columns_).data_.arr, this->size_};
+    }
+
+    [[nodiscard]]
+    constexpr auto operator[](::std::size_t i) noexcept {
+        exception::assert_true(i < this->size_);
+        return soa_row<soa_vector>{this, i};
+    }
+
+    [[nodiscard]]
+    constexpr auto operator[](::std::size_t i) const noexcept {
+        exception::assert_true(i < this->size_);
+        return soa_row<soa_vector const>{this, i};
+    }
+
+    [[nodiscard]]
+    constexpr ::std::size_t size() const noexcept {
+        return this->size_;
+    }
+
+    [[nodiscard]]
+    constexpr bool empty() const noexcept {
+        return this->size_ == 0;
+    }
+
+    [[nodiscard]]
+    static constexpr ::std::size_t capacity() noexcept {
+        return Cap;
+    }
+};
+
+namespace details {
+
+template<typename>
+constexpr bool is_soa_vector_ = false;
+
+template<typename Schema, ::std::size_t Cap>
+constexpr bool is_soa_vector_<soa_vector<Schema, Cap>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_soa_vector = details::is_soa_vector_<::std::remove_cvref_t<T>>;
+
+/* A reference to one row of a soa_vector
+ *
+ * Fields are reached with get<"name">(row) or get<I>(row), and structured
+ * bindings of a row are references into the columns.
+ */
+template<typename Table>
+class soa_row {
+    Table* table_;
+    ::std::size_t index_;
+
+public:
+    using names = typename ::std::remove_const_t<Table>::names;
+
+    constexpr soa_row(Table* table, ::std::size_t index) noexcept
+        : table_{table},
+          index_{index} {
+    }
+
+    template<::std::size_t I>
+    [[nodiscard]]
+    constexpr auto& field() const noexcept {
+        return this->table_->template column<I>()[this->index_];
+    }
+
+    [[nodiscard]]
+    constexpr ::std::size_t index() const noexcept {
+        return this->index_;
+    }
+};
+
+/* get soa_row field by name
+ *
+ * Usage: get<"name">(table[i])
+ */
+template<string::string str, typename Table>
+[[nodiscard]]
+constexpr auto& get(soa_row<Table> row) noexcept {
+    using names_type = typename soa_row<Table>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return row.template field<index>();
+}
+
+template<::std::size_t N, typename Table>
+[[nodiscard]]
+constexpr auto& get(soa_row<Table> row) noexcept {
+    return row.template field<N>();
+}
+
+/* Contiguous values of one field as a ::std::span
+ *
+ * Usage: column<"price">(table)
+ */
+template<string::string str, is_soa_vector Table>
+[[nodiscard]]
+constexpr auto column(Table& table) noexcept {
+    using names_type = typename ::std::remove_cvref_t<Table>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return table.template column<index>();
+}
+
+} // namespace ctb::namedtuple
+
+template<typename Table>
+struct std::tuple_size<::ctb::namedtuple::soa_row<Table>>
+    : public ::std::integral_constant<::std::size_t, ::ctb::namedtuple::details::get_size<
+                                                         typename ::ctb::namedtuple::soa_row<Table>::names>()> {};
+
+template<::std::size_t N, typename Table>
+struct std::tuple_element<N, ::ctb::namedtuple::soa_row<Table>> {
+    using type = decltype(::std::declval<::ctb::namedtuple::soa_row<Table>>().template field<N>());
+};
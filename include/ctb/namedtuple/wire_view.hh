@@ -0,0 +1,229 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include "../exception.hh"
+#include "../namedtuple.hh"
+#include "../tuple/binary.hh"
+#include "../utils.hh"
+#include "binary.hh"
+
+/* Zero-copy views of fixed binary headers described by a namedtuple
+ *
+ * Fields are packed without padding in the order of the schema, in the byte
+ * order Endian (network order by default). The offset of every field is known
+ * at compile time, so reading a field is one unaligned load plus a byteswap,
+ * and writing one is a byteswap plus one store, in place. The length of the
+ * buffer is checked once, when the view is made.
+ *
+ * Usage: using header = namedtuple<names<"len", "seq">, std::uint16_t, std::uint32_t>;
+ *        auto view = make_wire_view<header>(std::span{buf}).value();
+ *        get<"seq">(view);
+ *        set<"seq">(view, 1);
+ */
+namespace ctb::namedtuple {
+
+namespace details {
+
+/* scalars, and namedtuples of those which are viewed as nested headers
+ */
+template<typename T>
+constexpr bool is_wire_view_field_ = ::ctb::tuple::details::is_wire_scalar_<T>;
+
+template<is_names Names, typename... Args>
+constexpr bool is_wire_view_field_<namedtuple<Names, Args...>> = (is_wire_view_field_<Args> && ...);
+
+} // namespace details
+
+template<typename Schema, ::std::endian Endian = ::std::endian::big, typename Byte = ::std::byte const>
+    requires (is_namedtuple<Schema> && details::is_wire_view_field_<Schema> &&
+              ::std::is_same_v<::std::remove_const_t<Byte>, ::std::byte>)
+class wire_view;
+
+/* A view of a Schema header at data, writable unless Byte is const
+ */
+template<details::is_names Names, typename... Args, ::std::endian Endian, typename Byte>
+class wire_view<namedtuple<Names, Args...>, Endian, Byte> {
+    Byte* data_;
+
+public:
+    using schema = namedtuple<Names, Args...>;
+    using names = Names;
+
+    /* number of bytes of the header
+     */
+    static constexpr ::std::size_t size{::ctb::tuple::details::wire_traits_<schema>::size};
+
+    /* data must hold at least size bytes, see make_wire_view for the checked way
+     */
+    explicit constexpr wire_view(Byte* data) noexcept
+        : data_{data} {
+    }
+
+    [[nodiscard]]
+    constexpr operator wire_view<schema, Endian, ::std::byte const>() const noexcept {
+        return wire_view<schema, Endian, ::std::byte const>{this->data_};
+    }
+
+    [[nodiscard]]
+    constexpr Byte* data() const noexcept {
+        return this->data_;
+    }
+
+    /* value of a scalar field, or a view of a nested header
+     */
+    template<::std::size_t I>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    auto field() const noexcept {
+        static_assert(I < sizeof...(Args), "ctb::namedtuple::IndexError: index out of range");
+        using T = ::ctb::utils::pack_indexing_t<I, Args...>;
+        constexpr auto offset = ::ctb::tuple::details::wire_offset_<I, Args...>;
+        if constexpr (is_namedtuple<T>) {
+            return wire_view<T, Endian, Byte>{this->data_ + offset};
+        } else {
+            return ::ctb::tuple::details::load_scalar_<Endian, T>(this->data_ + offset);
+        }
+    }
+
+    template<::std::size_t I>
+        requires (!::std::is_const_v<Byte>)
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    void set_field(::ctb::utils::pack_indexing_t<I, Args...> const& val) const noexcept {
+        using T = ::ctb::utils::pack_indexing_t<I, Args...>;
+        constexpr auto offset = ::ctb::tuple::details::wire_offset_<I, Args...>;
+        if constexpr (is_namedtuple<T>) {
+            wire_view<T, Endian, Byte>{this->data_ + offset}.store(val);
+        } else {
+            ::ctb::tuple::details::store_scalar_<Endian>(val, this->data_ + offset);
+        }
+    }
+
+    /* copy the whole header out
+     */
+    [[nodiscard]]
+    schema load() const noexcept {
+        schema res{};
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            ((::ctb::namedtuple::get<I>(res) = wire_view::load_field_<I>()), ...);
+        }(::std::index_sequence_for<Args...>{});
+        return res;
+    }
+
+    /* write every field of val in place
+     */
+    void store(schema const& val) const noexcept
+        requires (!::std::is_const_v<Byte>)
+    {
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            (this->template set_field<I>(::ctb::namedtuple::get<I>(val)), ...);
+        }(::std::index_sequence_for<Args...>{});
+    }
+
+private:
+    template<::std::size_t I>
+    [[nodiscard]]
+    auto load_field_() const noexcept {
+        if constexpr (is_namedtuple<::ctb::utils::pack_indexing_t<I, Args...>>) {
+            return this->template field<I>().load();
+        } else {
+            return this->template field<I>();
+        }
+    }
+};
+
+/* View bytes as a Schema header, nullopt if bytes is shorter than the header
+ *
+ * Usage: make_wire_view<header>(std::span{buf})
+ */
+template<typename Schema, ::std::endian Endian = ::std::endian::big, typename Byte, ::std::size_t Extent>
+    requires (is_namedtuple<Schema> && details::is_wire_view_field_<Schema> &&
+              ::std::is_same_v<::std::remove_const_t<Byte>, ::std::byte>)
+[[nodiscard]]
+constexpr exception::optional<wire_view<Schema, Endian, Byte>>
+make_wire_view(::std::span<Byte, Extent> bytes) noexcept {
+    if constexpr (Extent != ::std::dynamic_extent) {
+        static_assert(Extent >= wire_view<Schema, Endian, Byte>::size,
+                      "ctb::namedtuple::WireError: buffer is shorter than the header");
+    } else if (bytes.size() < wire_view<Schema, Endian, Byte>::size) [[unlikely]] {
+        return exception::nullopt;
+    }
+    return wire_view<Schema, Endian, Byte>{bytes.data()};
+}
+
+/* get wire_view field by index
+ *
+ * Usage: get<1>(view)
+ */
+template<::std::size_t N, typename Schema, ::std::endian Endian, typename Byte>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+inline auto get(wire_view<Schema, Endian, Byte> view) noexcept {
+    return view.template field<N>();
+}
+
+/* get wire_view field by name
+ *
+ * Usage: get<"name">(view)
+ */
+template<string::string str, typename Schema, ::std::endian Endian, typename Byte>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+inline auto get(wire_view<Schema, Endian, Byte> view) noexcept {
+    using names_type = typename wire_view<Schema, Endian, Byte>::names;
+    constexpr auto index = details::get_index<str, names_type>();
+    static_assert(index < details::get_size<names_type>(), "ctb::namedtuple::NameError: no such field");
+    return view.template field<index>();
+}
+
+/* set wire_view field by index, in place
+ */
+template<::std::size_t N, typename Schema, ::std::endian Endian>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+inline void set(wire_view<Schema, Endian, ::std::byte> view,
+                ::std::tuple_element_t<N, Schema> const& val) noexcept {
+    view.template set_field<N>(val);
+}
+
+/* set wire_view field by name, in place
+ *
+ * Usage: set<"name">(view, 1)
+ */
+template<string::string str, typename Schema, ::std::endian Endian>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+inline void set(wire_view<Schema, Endian, ::std::byte> view,
+                ::std::tuple_element_t<details::get_index<str, typename Schema::names>(), Schema> const& val) noexcept {
+    view.template set_field<details::get_index<str, typename Schema::names>()>(val);
+}
+
+} // namespace ctb::namedtuple
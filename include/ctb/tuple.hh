@@ -4,8 +4,11 @@
     #error "`ctb` requires at least C++20"
 #endif // __cpp_concepts < 201907L
 
+#include <compare>
 #include <cstddef>
 #include <concepts>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 #include "utils.hh"
 
@@ -44,6 +47,18 @@ struct tuple<> {};
 template<typename... Args>
 tuple(Args&&...) -> tuple<Args...>;
 
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::tuple<Args...>& self) noexcept {
+    return static_cast<::ctb::tuple::details::tuple_element_impl_<I, ::ctb::utils::pack_indexing_t<I, Args...>>&>(self)
+        .val_;
+}
+
 template<::std::size_t I, typename... Args>
 #if __has_cpp_attribute(__gnu__::__always_inline__)
 [[__gnu__::__always_inline__]]
@@ -57,6 +72,18 @@ constexpr auto&& get(::ctb::tuple::tuple<Args...> const& self) noexcept {
         .val_;
 }
 
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::tuple<Args...>&& self) noexcept {
+    using type = ::ctb::utils::pack_indexing_t<I, Args...>;
+    return static_cast<type&&>(static_cast<::ctb::tuple::details::tuple_element_impl_<I, type>&>(self).val_);
+}
+
 template<::std::size_t I, typename... Args>
 #if __has_cpp_attribute(__gnu__::__always_inline__)
 [[__gnu__::__always_inline__]]
@@ -65,28 +92,59 @@ template<::std::size_t I, typename... Args>
 #endif
 [[nodiscard]]
 constexpr auto&& get(::ctb::tuple::tuple<Args...> const&& self) noexcept {
-    return ::std::move(
-        static_cast<
-            ::ctb::tuple::details::tuple_element_impl_<I, ::ctb::utils::pack_indexing_t<I, Args...>> const&&>(
-            self)
-            .val_);
+    using type = ::ctb::utils::pack_indexing_t<I, Args...>;
+    return static_cast<type const&&>(
+        static_cast<::ctb::tuple::details::tuple_element_impl_<I, type> const&>(self).val_);
 }
 
 namespace details {
 
-template<typename T, ::std::size_t I, typename Current, typename... Args>
-constexpr auto get_tuple_element_by_type_() noexcept {
-    if constexpr (::std::same_as<T, Current>) {
-        return ::ctb::utils::pass_type<tuple_element_impl_<I, Current>>{};
-    } else {
-        return ::ctb::tuple::details::get_tuple_element_by_type_<T, I + 1, Args...>();
-    }
-}
+/* Field lookup by type in constant template depth, deducing I from the base
+ * tuple_element_impl_<I, T> fails when T is not a field or is more than one
+ */
+template<typename T, ::std::size_t I>
+tuple_element_impl_<I, T> select_element_by_type_(tuple_element_impl_<I, T> const&) noexcept;
+
+template<typename T, typename Tuple>
+concept has_unique_element_ = requires(Tuple const& t) { details::select_element_by_type_<T>(t); };
+
+template<typename T, typename Tuple>
+    requires (has_unique_element_<T, Tuple>)
+using element_by_type_t_ = decltype(details::select_element_by_type_<T>(::std::declval<Tuple const&>()));
+
+template<typename>
+struct element_index_;
+
+template<::std::size_t I, typename T>
+struct element_index_<tuple_element_impl_<I, T>> : ::std::integral_constant<::std::size_t, I> {};
+
+/* index of the field of type T in Tuple
+ */
+template<typename T, typename Tuple>
+    requires (has_unique_element_<T, Tuple>)
+inline constexpr ::std::size_t type_index_v_{element_index_<element_by_type_t_<T, Tuple>>::value};
+
+/* From brace-initializes a To, so the conversion does not narrow
+ */
+template<typename To, typename From>
+concept is_brace_constructible_ = requires(From&& from) { To{::std::forward<From>(from)}; };
 
 } // namespace details
 
 template<typename T, typename... Args>
-    requires ((::std::same_as<T, Args> + ...) == 1)
+    requires (::ctb::tuple::details::has_unique_element_<T, ::ctb::tuple::tuple<Args...>>)
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::tuple<Args...>& self) noexcept {
+    return static_cast<::ctb::tuple::details::element_by_type_t_<T, ::ctb::tuple::tuple<Args...>>&>(self).val_;
+}
+
+template<typename T, typename... Args>
+    requires (::ctb::tuple::details::has_unique_element_<T, ::ctb::tuple::tuple<Args...>>)
 #if __has_cpp_attribute(__gnu__::__always_inline__)
 [[__gnu__::__always_inline__]]
 #elif __has_cpp_attribute(msvc::forceinline)
@@ -94,12 +152,24 @@ template<typename T, typename... Args>
 #endif
 [[nodiscard]]
 constexpr auto&& get(::ctb::tuple::tuple<Args...> const& self) noexcept {
-    return static_cast<decltype(::ctb::tuple::details::get_tuple_element_by_type_<T, 0, Args...>())::type const&>(self)
-        .val_;
+    return static_cast<::ctb::tuple::details::element_by_type_t_<T, ::ctb::tuple::tuple<Args...>> const&>(self).val_;
 }
 
 template<typename T, typename... Args>
-    requires ((::std::same_as<T, Args> + ...) == 1)
+    requires (::ctb::tuple::details::has_unique_element_<T, ::ctb::tuple::tuple<Args...>>)
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::tuple<Args...>&& self) noexcept {
+    using impl = ::ctb::tuple::details::element_by_type_t_<T, ::ctb::tuple::tuple<Args...>>;
+    return static_cast<T&&>(static_cast<impl&>(self).val_);
+}
+
+template<typename T, typename... Args>
+    requires (::ctb::tuple::details::has_unique_element_<T, ::ctb::tuple::tuple<Args...>>)
 #if __has_cpp_attribute(__gnu__::__always_inline__)
 [[__gnu__::__always_inline__]]
 #elif __has_cpp_attribute(msvc::forceinline)
@@ -107,9 +177,8 @@ template<typename T, typename... Args>
 #endif
 [[nodiscard]]
 constexpr auto&& get(::ctb::tuple::tuple<Args...> const&& self) noexcept {
-    return ::std::move(
-        static_cast<decltype(::ctb::tuple::details::get_tuple_element_by_type_<T, 0, Args...>())::type const&&>(self)
-            .val_);
+    using impl = ::ctb::tuple::details::element_by_type_t_<T, ::ctb::tuple::tuple<Args...>>;
+    return static_cast<T const&&>(static_cast<impl const&>(self).val_);
 }
 
 namespace details {
@@ -125,6 +194,18 @@ constexpr bool is_tuple_<tuple<Args...>> = true;
 template<typename T>
 concept is_tuple = ::ctb::tuple::details::is_tuple_<::std::remove_cvref_t<T>>;
 
+namespace details {
+
+/* types taken by ctb/tuple/algorithm.hh, packed_tuple and padded_tuple add themselves
+ */
+template<typename T>
+constexpr bool is_tuple_like_ = is_tuple_<T>;
+
+} // namespace details
+
+template<typename T>
+concept is_tuple_like = ::ctb::tuple::details::is_tuple_like_<::std::remove_cvref_t<T>>;
+
 template<typename... Args>
 [[nodiscard]]
 constexpr auto forward_as_tuple(Args&&... args) {
@@ -132,12 +213,66 @@ constexpr auto forward_as_tuple(Args&&... args) {
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wmissing-braces"
 #endif
-    return ::ctb::tuple::tuple<Args&&...>(::std::forward<Args>(args)...);
+    return ::ctb::tuple::tuple<Args&&...>{::std::forward<Args>(args)...};
 #if defined(__clang__)
     #pragma clang diagnostic pop
 #endif
 }
 
+namespace details {
+
+template<typename T, typename U>
+concept equality_comparable_with_ = requires(T const& a, U const& b) {
+    { a == b } -> ::std::convertible_to<bool>;
+};
+
+template<typename T, typename U>
+concept three_way_comparable_with_ = requires(T const& a, U const& b) { a <=> b; };
+
+/* integer fields without padding, two such tuples are equal iff their bytes are
+ */
+template<typename Tuple>
+constexpr bool is_bitwise_comparable_ = false;
+
+template<typename... Args>
+constexpr bool is_bitwise_comparable_<tuple<Args...>> =
+    sizeof...(Args) != 0 && (::std::is_integral_v<Args> && ...) &&
+    ::std::has_unique_object_representations_v<tuple<Args...>>;
+
+} // namespace details
+
+/* field by field, a tuple of padding-free integers is compared with one memcmp
+ */
+template<typename... Args, typename... Brgs>
+    requires (sizeof...(Args) == sizeof...(Brgs) && (details::equality_comparable_with_<Args, Brgs> && ...))
+[[nodiscard]]
+constexpr bool operator==(::ctb::tuple::tuple<Args...> const& lhs, ::ctb::tuple::tuple<Brgs...> const& rhs) noexcept {
+    if constexpr (::std::is_same_v<tuple<Args...>, tuple<Brgs...>> &&
+                  details::is_bitwise_comparable_<tuple<Args...>>) {
+        if (!::std::is_constant_evaluated()) {
+            return ::std::memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+        }
+    }
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        return ((::ctb::tuple::get<I>(lhs) == ::ctb::tuple::get<I>(rhs)) && ...);
+    }(::std::index_sequence_for<Args...>{});
+}
+
+/* lexicographic, stops at the first field that differs
+ */
+template<typename... Args, typename... Brgs>
+    requires (sizeof...(Args) == sizeof...(Brgs) && (details::three_way_comparable_with_<Args, Brgs> && ...))
+[[nodiscard]]
+constexpr ::std::common_comparison_category_t<::std::compare_three_way_result_t<Args, Brgs>...>
+operator<=>(::ctb::tuple::tuple<Args...> const& lhs, ::ctb::tuple::tuple<Brgs...> const& rhs) noexcept {
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        ::std::common_comparison_category_t<::std::compare_three_way_result_t<Args, Brgs>...> res{
+            ::std::strong_ordering::equal};
+        static_cast<void>((((res = ::ctb::tuple::get<I>(lhs) <=> ::ctb::tuple::get<I>(rhs)) == 0) && ...));
+        return res;
+    }(::std::index_sequence_for<Args...>{});
+}
+
 } // namespace ctb::tuple
 
 template<::std::size_t I, typename... Args>
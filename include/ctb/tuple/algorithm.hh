@@ -0,0 +1,224 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../tuple.hh"
+#include "../utils.hh"
+
+/* Algorithms over tuples
+ *
+ * Every function expands one index sequence, so the instantiation depth does
+ * not grow with the number of fields. Fields are reached with get<I> on the
+ * forwarded tuple, so the fields of an rvalue tuple are moved, never copied,
+ * and reference fields stay references. Takes tuple, packed_tuple and padded_tuple.
+ *
+ * Usage: apply([](int a, double b) { return a + b; }, tuple{1, 2.});
+ *        tuple_cat(tuple{1}, tuple{2., 'c'});
+ *        visit_at(t, column, [](auto& field) { ... });
+ */
+namespace ctb::tuple {
+
+namespace details {
+
+template<typename Tuple>
+inline constexpr ::std::size_t tuple_size_v_{::std::tuple_size<::std::remove_cvref_t<Tuple>>::value};
+
+template<typename Tuple>
+using index_sequence_of_t_ = ::std::make_index_sequence<tuple_size_v_<Tuple>>;
+
+/* the field I of t with the value category of t
+ */
+template<::std::size_t I, typename Tuple>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr decltype(auto) get_forward_(Tuple&& t) noexcept {
+    return get<I>(::std::forward<Tuple>(t));
+}
+
+/* which tuple and which field of it is the K-th field of tuple_cat
+ */
+template<::std::size_t... Size>
+struct cat_indices_ {
+    static constexpr ::std::size_t size_{(Size + ... + 0)};
+
+    [[nodiscard]]
+    static consteval auto make_() noexcept {
+        ::std::array<::std::size_t, sizeof...(Size)> const sizes{Size...};
+        ::std::array<::std::array<::std::size_t, 2>, size_> res{};
+        ::std::size_t k{};
+        for (::std::size_t i{}; i < sizes.size(); ++i) {
+            for (::std::size_t j{}; j < sizes[i]; ++j) {
+                res[k++] = {i, j};
+            }
+        }
+        return res;
+    }
+
+    static constexpr auto value_{cat_indices_::make_()};
+};
+
+template<typename... Tuples, ::std::size_t... K>
+[[nodiscard]]
+constexpr auto tuple_cat_(::std::index_sequence<K...>, Tuples&&... tuples) noexcept {
+    using indices = cat_indices_<tuple_size_v_<Tuples>...>;
+    [[maybe_unused]] auto refs = ::ctb::tuple::forward_as_tuple(::std::forward<Tuples>(tuples)...);
+    using result_type = ::ctb::tuple::tuple<typename ::std::tuple_element<
+        indices::value_[K][1],
+        ::std::remove_cvref_t<::ctb::utils::pack_indexing_t<indices::value_[K][0], Tuples...>>>::type...>;
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+    return result_type{details::get_forward_<indices::value_[K][1]>(
+        ::ctb::tuple::get<indices::value_[K][0]>(::std::move(refs)))...};
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+}
+
+template<typename Tuple, typename Visitor, ::std::size_t I>
+using visit_at_result_ = ::std::invoke_result_t<Visitor&, decltype(details::get_forward_<I>(::std::declval<Tuple>()))>;
+
+template<typename Tuple, typename Visitor, ::std::size_t... I>
+[[nodiscard]]
+consteval auto get_visit_at_result_(::std::index_sequence<I...>) noexcept {
+    if constexpr ((::std::is_void_v<visit_at_result_<Tuple, Visitor, I>> && ...)) {
+        return ::ctb::utils::pass_type<void>{};
+    } else {
+        return ::ctb::utils::pass_type<::std::common_type_t<visit_at_result_<Tuple, Visitor, I>...>>{};
+    }
+}
+
+/* void if visitor returns void for every field, else the common type of its results
+ */
+template<typename Tuple, typename Visitor>
+using visit_at_result_t_ =
+    typename decltype(details::get_visit_at_result_<Tuple, Visitor>(index_sequence_of_t_<Tuple>{}))::type;
+
+/* one function per field, a static table so it lives in .rodata
+ */
+template<typename Tuple, typename Visitor, ::std::size_t... I>
+[[nodiscard]]
+consteval auto make_visit_at_table_(::std::index_sequence<I...>) noexcept {
+    using tuple_type = ::std::remove_reference_t<Tuple>;
+    using visitor_type = ::std::remove_reference_t<Visitor>;
+    using result_type = details::visit_at_result_t_<Tuple, Visitor>;
+    using fn_type = result_type (*)(tuple_type*, visitor_type*);
+    return ::std::array<fn_type, sizeof...(I)>{+[](tuple_type* t, visitor_type* v) {
+        return static_cast<result_type>((*v)(details::get_forward_<I>(static_cast<Tuple&&>(*t))));
+    }...};
+}
+
+template<typename Tuple, typename Visitor>
+inline constexpr auto visit_at_table_{details::make_visit_at_table_<Tuple, Visitor>(index_sequence_of_t_<Tuple>{})};
+
+} // namespace details
+
+/* Call f with the fields of t
+ */
+template<typename F, is_tuple_like Tuple>
+constexpr decltype(auto) apply(F&& f, Tuple&& t) noexcept {
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) -> decltype(auto) {
+        return ::std::forward<F>(f)(details::get_forward_<I>(::std::forward<Tuple>(t))...);
+    }(details::index_sequence_of_t_<Tuple>{});
+}
+
+/* Call f with every field of t in order
+ */
+template<is_tuple_like Tuple, typename F>
+constexpr void for_each(Tuple&& t, F&& f) noexcept {
+    [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        (static_cast<void>(f(details::get_forward_<I>(::std::forward<Tuple>(t)))), ...);
+    }(details::index_sequence_of_t_<Tuple>{});
+}
+
+/* Call f with the index, as a ::std::integral_constant, and every field of t in order
+ *
+ * Usage: for_each_indexed(t, [](auto i, auto const& val) { print(get_name<i>(), val); });
+ */
+template<is_tuple_like Tuple, typename F>
+constexpr void for_each_indexed(Tuple&& t, F&& f) noexcept {
+    [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        (static_cast<void>(f(::std::integral_constant<::std::size_t, I>{},
+                             details::get_forward_<I>(::std::forward<Tuple>(t)))),
+         ...);
+    }(details::index_sequence_of_t_<Tuple>{});
+}
+
+/* tuple of f applied to every field of t, in order
+ */
+template<is_tuple_like Tuple, typename F>
+[[nodiscard]]
+constexpr auto transform(Tuple&& t, F&& f) noexcept {
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+        // braced initialization, so f is called in order
+        return ::ctb::tuple::tuple<decltype(f(details::get_forward_<I>(::std::forward<Tuple>(t))))...>{
+            f(details::get_forward_<I>(::std::forward<Tuple>(t)))...};
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+    }(details::index_sequence_of_t_<Tuple>{});
+}
+
+/* tuple of the fields of all tuples, in order
+ */
+template<is_tuple_like... Tuples>
+[[nodiscard]]
+constexpr auto tuple_cat(Tuples&&... tuples) noexcept {
+    return details::tuple_cat_(::std::make_index_sequence<(details::tuple_size_v_<Tuples> + ... + 0)>{},
+                               ::std::forward<Tuples>(tuples)...);
+}
+
+/* Call visitor with the field i of t, i must be less than the size of t
+ *
+ * One indirect call through a table of one function per field, whatever the
+ * number of fields. Returns void if visitor returns void for every field,
+ * else the common type of its results.
+ *
+ * Usage: visit_at(t, column, [](auto const& field) { return static_cast<double>(field); });
+ */
+template<is_tuple_like Tuple, typename Visitor>
+constexpr details::visit_at_result_t_<Tuple&&, Visitor&&> visit_at(Tuple&& t, ::std::size_t i,
+                                                                   Visitor&& visitor) noexcept {
+    constexpr auto const& table = details::visit_at_table_<Tuple&&, Visitor&&>;
+    exception::assert_true(i < table.size());
+    return table[i](&t, &visitor);
+}
+
+/* Construct a T from the fields of t, with braces if T is an aggregate
+ */
+template<typename T, is_tuple_like Tuple>
+[[nodiscard]]
+constexpr T make_from_tuple(Tuple&& t) noexcept {
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        if constexpr (::std::is_aggregate_v<T>) {
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+            return T{details::get_forward_<I>(::std::forward<Tuple>(t))...};
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+        } else {
+            return T(details::get_forward_<I>(::std::forward<Tuple>(t))...);
+        }
+    }(details::index_sequence_of_t_<Tuple>{});
+}
+
+} // namespace ctb::tuple
@@ -0,0 +1,344 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../tuple.hh"
+#include "../utils.hh"
+
+/* Flat binary encoding of tuples
+ *
+ * The wire format is a 64-bit schema hash followed by every field, packed
+ * without padding, little-endian. Only fixed-size fields are supported
+ * (arithmetic types, enums and nested tuples), so the wire size is known
+ * at compile time and decoding is a bounds check, a hash compare and copies.
+ *
+ * Usage: auto len = encode(t, buf);
+ *        auto res = decode<tuple<int, double>>(buf);
+ */
+namespace ctb::tuple {
+
+enum class binary_errc : unsigned char {
+    too_short = 1,
+    schema_mismatch,
+    invalid_value,
+};
+
+namespace details {
+
+inline constexpr ::std::uint64_t fnv_offset_{0xcbf29ce484222325u};
+inline constexpr ::std::uint64_t fnv_prime_{0x100000001b3u};
+
+[[nodiscard]]
+constexpr ::std::uint64_t hash_combine_(::std::uint64_t h, ::std::uint64_t val) noexcept {
+    for (::std::size_t i{}; i < sizeof(val); ++i) {
+        h ^= (val >> (i * 8)) & 0xff;
+        h *= fnv_prime_;
+    }
+    return h;
+}
+
+/* codes of the schema hash, they only need to be distinct
+ */
+enum class wire_code_ : ::std::uint64_t {
+    boolean = 1,
+    signed_integer,
+    unsigned_integer,
+    floating_point,
+    tuple_begin,
+    tuple_end,
+    namedtuple_begin,
+    namedtuple_end,
+};
+
+template<typename T>
+concept is_wire_scalar_ = (::std::is_arithmetic_v<T> || ::std::is_enum_v<T>) &&
+                          (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template<typename T>
+struct wire_scalar_bits_ {
+    using type = ::std::conditional_t<
+        sizeof(T) == 1, ::std::uint8_t,
+        ::std::conditional_t<sizeof(T) == 2, ::std::uint16_t,
+                             ::std::conditional_t<sizeof(T) == 4, ::std::uint32_t, ::std::uint64_t>>>;
+};
+
+/* How a type is laid out on the wire
+ *
+ * size is the number of bytes, hash(h) feeds the structure of the type into h,
+ * valid(in) tells whether the bytes hold a value of T (a bool is 0 or 1),
+ * write and read copy one value, read fills a value-initialized T. Specialized
+ * for tuple here and for namedtuple in ctb/namedtuple/binary.hh.
+ */
+template<typename T>
+struct wire_traits_;
+
+template<typename T>
+concept is_wire_type_ = requires { wire_traits_<T>::size; };
+
+/* Unaligned store and load of a scalar in the byte order Endian,
+ * one move plus a byteswap if Endian is not the native order. A bool is
+ * loaded from its byte, any byte but 0 is true.
+ */
+template<::std::endian Endian, is_wire_scalar_ T>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+inline void store_scalar_(T const& val, ::std::byte* out) noexcept {
+    if constexpr (Endian == ::std::endian::native || sizeof(T) == 1) {
+        ::std::memcpy(out, &val, sizeof(T));
+    } else {
+        auto const bits = ::ctb::utils::byteswap(::std::bit_cast<typename wire_scalar_bits_<T>::type>(val));
+        ::std::memcpy(out, &bits, sizeof(T));
+    }
+}
+
+template<::std::endian Endian, is_wire_scalar_ T>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+inline T load_scalar_(::std::byte const* in) noexcept {
+    if constexpr (::std::is_same_v<T, bool>) {
+        return *in != ::std::byte{};
+    } else if constexpr (Endian == ::std::endian::native || sizeof(T) == 1) {
+        T res;
+        ::std::memcpy(&res, in, sizeof(T));
+        return res;
+    } else {
+        typename wire_scalar_bits_<T>::type bits;
+        ::std::memcpy(&bits, in, sizeof(T));
+        return ::std::bit_cast<T>(::ctb::utils::byteswap(bits));
+    }
+}
+
+template<is_wire_scalar_ T>
+struct wire_traits_<T> {
+    static constexpr ::std::size_t size{sizeof(T)};
+
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash(::std::uint64_t h) noexcept {
+        using value_type = typename decltype([] {
+            if constexpr (::std::is_enum_v<T>) {
+                return ::ctb::utils::pass_type<::std::underlying_type_t<T>>{};
+            } else {
+                return ::ctb::utils::pass_type<T>{};
+            }
+        }())::type;
+        wire_code_ code{};
+        if constexpr (::std::is_same_v<value_type, bool>) {
+            code = wire_code_::boolean;
+        } else if constexpr (::std::is_floating_point_v<value_type>) {
+            code = wire_code_::floating_point;
+        } else if constexpr (::std::is_signed_v<value_type>) {
+            code = wire_code_::signed_integer;
+        } else {
+            code = wire_code_::unsigned_integer;
+        }
+        return details::hash_combine_(h, (static_cast<::std::uint64_t>(code) << 8) | sizeof(T));
+    }
+
+    [[nodiscard]]
+    static bool valid(::std::byte const* in) noexcept {
+        if constexpr (::std::is_same_v<T, bool>) {
+            return static_cast<unsigned char>(*in) <= 1;
+        } else {
+            static_cast<void>(in);
+            return true;
+        }
+    }
+
+    static void write(T const& val, ::std::byte* out) noexcept {
+        details::store_scalar_<::std::endian::little>(val, out);
+    }
+
+    static void read(::std::byte const* in, T& val) noexcept {
+        val = details::load_scalar_<::std::endian::little, T>(in);
+    }
+};
+
+/* A value of T whose bytes are all byte
+ */
+template<is_wire_scalar_ T>
+[[nodiscard]]
+consteval T wire_marker_(unsigned char byte) noexcept {
+    ::std::array<unsigned char, sizeof(T)> bytes{};
+    bytes.fill(byte);
+    return ::std::bit_cast<T>(bytes);
+}
+
+/* Whether the object representation of tuple<Args...> is the wire format,
+ * checked by marking each field with its own byte value
+ */
+template<typename... Args>
+[[nodiscard]]
+consteval bool is_wire_layout_() noexcept {
+    if constexpr (::std::endian::native != ::std::endian::little || sizeof...(Args) == 0 ||
+                  !((is_wire_scalar_<Args> && !::std::is_same_v<Args, bool>) && ...) ||
+                  sizeof(tuple<Args...>) != (sizeof(Args) + ... + 0)) {
+        return false;
+    } else {
+        return []<::std::size_t... I>(::std::index_sequence<I...>) {
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+            auto const bytes = ::std::bit_cast<::std::array<unsigned char, sizeof(tuple<Args...>)>>(
+                tuple<Args...>{details::wire_marker_<Args>(static_cast<unsigned char>(I + 1))...});
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+            ::std::size_t pos{};
+            bool res{true};
+            ((res = res && [&] {
+                 for (::std::size_t j{}; j < sizeof(Args); ++j) {
+                     if (bytes[pos++] != I + 1) {
+                         return false;
+                     }
+                 }
+                 return true;
+             }()),
+             ...);
+            return res;
+        }(::std::index_sequence_for<Args...>{});
+    }
+}
+
+/* byte offset of the I-th field of tuple<Args...> on the wire
+ */
+template<::std::size_t I, typename... Args>
+inline constexpr ::std::size_t wire_offset_{[]<::std::size_t... J>(::std::index_sequence<J...>) {
+    return (wire_traits_<::ctb::utils::pack_indexing_t<J, Args...>>::size + ... + 0);
+}(::std::make_index_sequence<I>{})};
+
+template<typename... Args>
+    requires (is_wire_type_<Args> && ...)
+struct wire_traits_<tuple<Args...>> {
+    using type_ = tuple<Args...>;
+
+    static constexpr ::std::size_t size{(wire_traits_<Args>::size + ... + 0)};
+    static constexpr bool is_memcpy_{details::is_wire_layout_<Args...>()};
+
+    [[nodiscard]]
+    static consteval ::std::uint64_t hash(::std::uint64_t h) noexcept {
+        h = details::hash_combine_(h, static_cast<::std::uint64_t>(wire_code_::tuple_begin));
+        ((h = wire_traits_<Args>::hash(h)), ...);
+        return details::hash_combine_(h, static_cast<::std::uint64_t>(wire_code_::tuple_end));
+    }
+
+    [[nodiscard]]
+    static bool valid(::std::byte const* in) noexcept {
+        return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            return (wire_traits_<Args>::valid(in + wire_offset_<I, Args...>) && ...);
+        }(::std::index_sequence_for<Args...>{});
+    }
+
+    static void write(type_ const& val, ::std::byte* out) noexcept {
+        if constexpr (is_memcpy_) {
+            ::std::memcpy(out, &val, size);
+        } else {
+            [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+                ((wire_traits_<Args>::write(::ctb::tuple::get<I>(val), out), out += wire_traits_<Args>::size), ...);
+            }(::std::index_sequence_for<Args...>{});
+        }
+    }
+
+    static void read(::std::byte const* in, type_& val) noexcept {
+        if constexpr (is_memcpy_) {
+            ::std::memcpy(&val, in, size);
+        } else {
+            [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+                ((wire_traits_<Args>::read(in, ::ctb::tuple::get<I>(val)), in += wire_traits_<Args>::size), ...);
+            }(::std::index_sequence_for<Args...>{});
+        }
+    }
+};
+
+template<is_wire_type_ T>
+[[nodiscard]]
+inline exception::optional<::std::size_t> encode_(T const& val, ::std::span<::std::byte> out) noexcept;
+
+template<is_wire_type_ T>
+[[nodiscard]]
+inline exception::expected<T, binary_errc> decode_(::std::span<::std::byte const> in) noexcept;
+
+} // namespace details
+
+/* Hash of the field types (and names for namedtuple) of T, the first
+ * 8 bytes of every encoded T
+ */
+template<typename T>
+    requires (details::is_wire_type_<T>)
+inline constexpr ::std::uint64_t schema_hash{details::wire_traits_<T>::hash(details::fnv_offset_)};
+
+/* Exact number of bytes of an encoded T
+ */
+template<typename T>
+    requires (details::is_wire_type_<T>)
+inline constexpr ::std::size_t wire_size{sizeof(::std::uint64_t) + details::wire_traits_<T>::size};
+
+namespace details {
+
+template<is_wire_type_ T>
+[[nodiscard]]
+inline exception::optional<::std::size_t> encode_(T const& val, ::std::span<::std::byte> out) noexcept {
+    if (out.size() < wire_size<T>) [[unlikely]] {
+        return exception::nullopt;
+    }
+    wire_traits_<::std::uint64_t>::write(schema_hash<T>, out.data());
+    wire_traits_<T>::write(val, out.data() + sizeof(::std::uint64_t));
+    return wire_size<T>;
+}
+
+template<is_wire_type_ T>
+[[nodiscard]]
+inline exception::expected<T, binary_errc> decode_(::std::span<::std::byte const> in) noexcept {
+    if (in.size() < wire_size<T>) [[unlikely]] {
+        return exception::unexpected{binary_errc::too_short};
+    }
+    ::std::uint64_t hash{};
+    wire_traits_<::std::uint64_t>::read(in.data(), hash);
+    if (hash != schema_hash<T>) [[unlikely]] {
+        return exception::unexpected{binary_errc::schema_mismatch};
+    }
+    if (!wire_traits_<T>::valid(in.data() + sizeof(::std::uint64_t))) [[unlikely]] {
+        return exception::unexpected{binary_errc::invalid_value};
+    }
+    T res{};
+    wire_traits_<T>::read(in.data() + sizeof(::std::uint64_t), res);
+    return res;
+}
+
+} // namespace details
+
+/* Write t into out, returns wire_size<T>, nullopt if out is too small
+ */
+template<typename... Args>
+    requires (details::is_wire_type_<tuple<Args...>>)
+[[nodiscard]]
+inline exception::optional<::std::size_t> encode(tuple<Args...> const& t, ::std::span<::std::byte> out) noexcept {
+    return details::encode_(t, out);
+}
+
+template<typename T>
+    requires (is_tuple<T> && details::is_wire_type_<T>)
+[[nodiscard]]
+inline exception::expected<T, binary_errc> decode(::std::span<::std::byte const> in) noexcept {
+    return details::decode_<T>(in);
+}
+
+} // namespace ctb::tuple
@@ -0,0 +1,102 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include "../tuple.hh"
+
+/* ::std::hash for tuple
+ *
+ * Field hashes are folded with one 64x64->128 bit multiply each, as
+ * ::std::hash of an integer is often the identity and needs mixing. A tuple
+ * of padding-free integers is hashed as its bytes, 8 at a time.
+ *
+ * Usage: std::unordered_set<tuple<int, long>> set;
+ */
+namespace ctb::tuple {
+
+namespace details {
+
+template<typename T>
+concept is_hashable_ = requires(T const& val) {
+    { ::std::hash<T>{}(val) } -> ::std::convertible_to<::std::size_t>;
+};
+
+inline constexpr ::std::uint64_t hash_seed_{0x9e3779b97f4a7c15};
+inline constexpr ::std::uint64_t hash_key_{0xe7037ed1a0b428db};
+
+/* multiply, fold the high half into the low one, not symmetric in its arguments
+ */
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr ::std::uint64_t hash_mix_(::std::uint64_t seed, ::std::uint64_t val) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128_type = unsigned __int128;
+    auto const res = static_cast<uint128_type>(seed ^ hash_seed_) * (val ^ hash_key_);
+    return static_cast<::std::uint64_t>(res) ^ static_cast<::std::uint64_t>(res >> 64);
+#else
+    auto const res = (::std::rotl(seed, 23) ^ val) * hash_seed_;
+    return res ^ (res >> 32);
+#endif
+}
+
+[[nodiscard]]
+inline ::std::uint64_t hash_bytes_(unsigned char const* ptr, ::std::size_t size) noexcept {
+    auto res = details::hash_mix_(hash_seed_, size);
+    for (; size >= sizeof(::std::uint64_t); ptr += sizeof(::std::uint64_t), size -= sizeof(::std::uint64_t)) {
+        ::std::uint64_t word;
+        ::std::memcpy(&word, ptr, sizeof(word));
+        res = details::hash_mix_(res, word);
+    }
+    if (size != 0) {
+        ::std::uint64_t word{};
+        ::std::memcpy(&word, ptr, size);
+        res = details::hash_mix_(res, word);
+    }
+    return res;
+}
+
+/* hash of the fields I of t, in order
+ */
+template<::std::size_t... I, typename Tuple>
+[[nodiscard]]
+inline ::std::size_t hash_fields_(Tuple const& t) noexcept {
+    auto res = hash_seed_;
+    static_cast<void>(((res = details::hash_mix_(
+                            res, ::std::hash<::std::remove_cvref_t<decltype(::ctb::tuple::get<I>(t))>>{}(
+                                     ::ctb::tuple::get<I>(t)))),
+                       ...));
+    return static_cast<::std::size_t>(res);
+}
+
+} // namespace details
+
+} // namespace ctb::tuple
+
+template<typename... Args>
+    requires (::ctb::tuple::details::is_hashable_<::std::remove_cvref_t<Args>> && ...)
+struct std::hash<::ctb::tuple::tuple<Args...>> {
+    [[nodiscard]]
+    ::std::size_t operator()(::ctb::tuple::tuple<Args...> const& t) const noexcept {
+        if constexpr (::ctb::tuple::details::is_bitwise_comparable_<::ctb::tuple::tuple<Args...>>) {
+            return static_cast<::std::size_t>(::ctb::tuple::details::hash_bytes_(
+                reinterpret_cast<unsigned char const*>(&t), sizeof(t)));
+        } else {
+            return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+                return ::ctb::tuple::details::hash_fields_<I...>(t);
+            }(::std::index_sequence_for<Args...>{});
+        }
+    }
+};
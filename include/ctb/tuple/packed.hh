@@ -0,0 +1,201 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../tuple.hh"
+#include "../utils.hh"
+
+/* A tuple whose fields are stored by decreasing alignment
+ *
+ * tuple lays its fields out in declaration order, so tuple<char, double, char, double>
+ * takes 32 bytes. packed_tuple sorts the storage at compile time (stable, so
+ * fields of the same alignment keep their order) and takes 24, while get<I>,
+ * get<T>, tuple_element and structured bindings keep the declaration order.
+ *
+ * Usage: packed_tuple<char, double, char> t{'a', 1., 'b'};
+ *        get<2>(t) == 'b';
+ */
+namespace ctb::tuple {
+
+namespace details {
+
+/* logical index of the field stored at each position
+ */
+template<typename... Args, ::std::size_t... I>
+[[nodiscard]]
+consteval ::std::array<::std::size_t, sizeof...(Args)> storage_order_(::std::index_sequence<I...>) noexcept {
+    ::std::array<::std::size_t, sizeof...(Args)> order{I...};
+    ::std::size_t const align[]{alignof(tuple_element_impl_<I, Args>)...};
+    // insertion sort, stable
+    for (::std::size_t i{1}; i < order.size(); ++i) {
+        auto const cur = order[i];
+        auto j = i;
+        for (; j > 0 && align[order[j - 1]] < align[cur]; --j) {
+            order[j] = order[j - 1];
+        }
+        order[j] = cur;
+    }
+    return order;
+}
+
+template<typename... Args>
+inline constexpr auto storage_order_v_{details::storage_order_<Args...>(::std::index_sequence_for<Args...>{})};
+
+template<typename... Args, ::std::size_t... K>
+[[nodiscard]]
+constexpr auto get_packed_tuple_impl_(::std::index_sequence<K...>) noexcept {
+    constexpr auto order = storage_order_v_<Args...>;
+
+    struct packed_tuple_impl_
+        : tuple_element_impl_<order[K], ::ctb::utils::pack_indexing_t<order[K], Args...>>... {};
+
+    return ::ctb::utils::pass_type<packed_tuple_impl_>();
+}
+
+template<typename... Args>
+using packed_tuple_impl_t_ =
+    typename decltype(details::get_packed_tuple_impl_<Args...>(::std::index_sequence_for<Args...>{}))::type;
+
+} // namespace details
+
+template<typename... Args>
+struct packed_tuple : details::packed_tuple_impl_t_<Args...> {
+private:
+    using impl_ = details::packed_tuple_impl_t_<Args...>;
+
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+    template<typename Refs, ::std::size_t... K>
+    constexpr packed_tuple(Refs&& refs, ::std::index_sequence<K...>) noexcept
+        : impl_{details::tuple_element_impl_<
+              details::storage_order_v_<Args...>[K],
+              ::ctb::utils::pack_indexing_t<details::storage_order_v_<Args...>[K], Args...>>{
+              ::ctb::tuple::get<details::storage_order_v_<Args...>[K]>(::std::move(refs))}...} {
+    }
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+
+public:
+    constexpr packed_tuple() noexcept = default;
+
+    /* fields in declaration order, narrowing arguments are rejected as in brace initialization
+     */
+    template<typename... Ts>
+        requires (sizeof...(Ts) == sizeof...(Args) && (details::is_brace_constructible_<Args, Ts&&> && ...))
+    constexpr packed_tuple(Ts&&... args) noexcept
+        : packed_tuple(::ctb::tuple::forward_as_tuple(::std::forward<Ts>(args)...),
+                       ::std::index_sequence_for<Args...>{}) {
+    }
+};
+
+template<>
+struct packed_tuple<> {};
+
+template<typename... Args>
+packed_tuple(Args...) -> packed_tuple<Args...>;
+
+namespace details {
+
+template<typename T>
+constexpr bool is_packed_tuple_ = false;
+
+template<typename... Args>
+constexpr bool is_packed_tuple_<packed_tuple<Args...>> = true;
+
+template<typename... Args>
+constexpr bool is_tuple_like_<packed_tuple<Args...>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_packed_tuple = ::ctb::tuple::details::is_packed_tuple_<::std::remove_cvref_t<T>>;
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::packed_tuple<Args...>& self) noexcept {
+    return static_cast<::ctb::tuple::details::tuple_element_impl_<I, ::ctb::utils::pack_indexing_t<I, Args...>>&>(self)
+        .val_;
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::packed_tuple<Args...> const& self) noexcept {
+    return static_cast<::ctb::tuple::details::tuple_element_impl_<
+        I, ::ctb::utils::pack_indexing_t<I, Args...>> const&>(self)
+        .val_;
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::packed_tuple<Args...>&& self) noexcept {
+    using type = ::ctb::utils::pack_indexing_t<I, Args...>;
+    return static_cast<type&&>(static_cast<::ctb::tuple::details::tuple_element_impl_<I, type>&>(self).val_);
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::packed_tuple<Args...> const&& self) noexcept {
+    using type = ::ctb::utils::pack_indexing_t<I, Args...>;
+    return static_cast<type const&&>(
+        static_cast<::ctb::tuple::details::tuple_element_impl_<I, type> const&>(self).val_);
+}
+
+/* get packed_tuple field by type, the type must be unique
+ *
+ * Usage: get<double>(t)
+ */
+template<typename T, typename Self>
+    requires (is_packed_tuple<Self>)
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(Self&& self) noexcept {
+    static_assert(details::has_unique_element_<T, ::std::remove_cvref_t<Self>>,
+                  "ctb::tuple::TypeError: the type must appear exactly once");
+    return ::ctb::tuple::get<details::type_index_v_<T, ::std::remove_cvref_t<Self>>>(::std::forward<Self>(self));
+}
+
+} // namespace ctb::tuple
+
+template<::std::size_t I, typename... Args>
+struct std::tuple_element<I, ::ctb::tuple::packed_tuple<Args...>> {
+    using type = ::ctb::utils::pack_indexing_t<I, Args...>;
+};
+
+template<typename... Args>
+struct std::tuple_size<::ctb::tuple::packed_tuple<Args...>> {
+    static constexpr ::std::size_t value = sizeof...(Args);
+};
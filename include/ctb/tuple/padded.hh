@@ -0,0 +1,228 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../tuple.hh"
+#include "../utils.hh"
+
+/* A tuple with chosen fields alone on their cache line
+ *
+ * A field declared as isolated<T> is stored as a T aligned to, and padded up
+ * to, utils::cache_line_size, so threads writing different isolated fields
+ * do not share a cache line. Other fields are laid out as in tuple. get<I>,
+ * get<T>, tuple_element and structured bindings see T, not isolated<T>.
+ *
+ * Usage: padded_tuple<isolated<std::uint64_t>, isolated<std::uint64_t>> counters{};
+ *        ++get<1>(counters);
+ */
+namespace ctb::tuple {
+
+/* marks a field of padded_tuple, never stored
+ */
+template<typename T>
+struct isolated {
+    using type = T;
+};
+
+namespace details {
+
+template<typename T>
+struct unwrap_isolated_ {
+    using type = T;
+};
+
+template<typename T>
+struct unwrap_isolated_<isolated<T>> {
+    using type = T;
+};
+
+template<typename T>
+using unwrap_isolated_t_ = typename unwrap_isolated_<T>::type;
+
+template<typename T>
+constexpr bool is_isolated_ = false;
+
+template<typename T>
+constexpr bool is_isolated_<isolated<T>> = true;
+
+/* bytes from the end of a field to the next cache line
+ */
+template<typename Base>
+inline constexpr ::std::size_t isolated_padding_{(::ctb::utils::cache_line_size -
+                                                  sizeof(Base) % ::ctb::utils::cache_line_size) %
+                                                 ::ctb::utils::cache_line_size};
+
+/* a tuple_element_impl_ on its own cache line, get casts through it to the base
+ *
+ * The padding is a member, as the tail padding of a base class may hold the next field.
+ */
+template<::std::size_t I, typename T>
+struct alignas(::ctb::utils::cache_line_size) isolated_element_impl_ : tuple_element_impl_<I, T> {
+    ::std::byte pad_[isolated_padding_<tuple_element_impl_<I, T>>];
+};
+
+template<::std::size_t I, typename T>
+    requires (isolated_padding_<tuple_element_impl_<I, T>> == 0)
+struct alignas(::ctb::utils::cache_line_size) isolated_element_impl_<I, T> : tuple_element_impl_<I, T> {};
+
+template<::std::size_t I, typename T>
+using padded_element_impl_t_ = ::std::conditional_t<is_isolated_<T>, isolated_element_impl_<I, unwrap_isolated_t_<T>>,
+                                                    tuple_element_impl_<I, T>>;
+
+template<typename... Args, ::std::size_t... Index>
+    requires (sizeof...(Args) == sizeof...(Index))
+[[nodiscard]]
+constexpr auto get_padded_tuple_impl_(::std::index_sequence<Index...>) noexcept {
+    struct padded_tuple_impl_ : padded_element_impl_t_<Index, Args>... {};
+
+    return ::ctb::utils::pass_type<padded_tuple_impl_>();
+}
+
+template<typename... Args>
+using padded_tuple_impl_t_ =
+    typename decltype(details::get_padded_tuple_impl_<Args...>(::std::index_sequence_for<Args...>{}))::type;
+
+} // namespace details
+
+template<typename... Args>
+struct padded_tuple : details::padded_tuple_impl_t_<Args...> {
+private:
+    using impl_ = details::padded_tuple_impl_t_<Args...>;
+
+    template<::std::size_t I, typename Ref>
+    [[nodiscard]]
+    static constexpr auto make_element_(Ref&& ref) noexcept {
+        using arg_type = ::ctb::utils::pack_indexing_t<I, Args...>;
+        using type = details::unwrap_isolated_t_<arg_type>;
+        using element_type = details::padded_element_impl_t_<I, arg_type>;
+        if constexpr (!details::is_isolated_<arg_type>) {
+            return element_type{type{::std::forward<Ref>(ref)}};
+        } else if constexpr (details::isolated_padding_<details::tuple_element_impl_<I, type>> == 0) {
+            return element_type{{type{::std::forward<Ref>(ref)}}};
+        } else {
+            return element_type{{type{::std::forward<Ref>(ref)}}, {}};
+        }
+    }
+
+    template<typename Refs, ::std::size_t... I>
+    constexpr padded_tuple(Refs&& refs, ::std::index_sequence<I...>) noexcept
+        : impl_{padded_tuple::make_element_<I>(::ctb::tuple::get<I>(::std::move(refs)))...} {
+    }
+
+public:
+    constexpr padded_tuple() noexcept = default;
+
+    /* fields in declaration order, narrowing arguments are rejected as in brace initialization
+     */
+    template<typename... Ts>
+        requires (sizeof...(Ts) == sizeof...(Args) &&
+                  (details::is_brace_constructible_<details::unwrap_isolated_t_<Args>, Ts&&> && ...))
+    constexpr padded_tuple(Ts&&... args) noexcept
+        : padded_tuple(::ctb::tuple::forward_as_tuple(::std::forward<Ts>(args)...),
+                       ::std::index_sequence_for<Args...>{}) {
+    }
+};
+
+template<>
+struct padded_tuple<> {};
+
+namespace details {
+
+template<typename T>
+constexpr bool is_padded_tuple_ = false;
+
+template<typename... Args>
+constexpr bool is_padded_tuple_<padded_tuple<Args...>> = true;
+
+template<typename... Args>
+constexpr bool is_tuple_like_<padded_tuple<Args...>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_padded_tuple = ::ctb::tuple::details::is_padded_tuple_<::std::remove_cvref_t<T>>;
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::padded_tuple<Args...>& self) noexcept {
+    using type = ::ctb::tuple::details::unwrap_isolated_t_<::ctb::utils::pack_indexing_t<I, Args...>>;
+    return static_cast<::ctb::tuple::details::tuple_element_impl_<I, type>&>(self).val_;
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::padded_tuple<Args...> const& self) noexcept {
+    using type = ::ctb::tuple::details::unwrap_isolated_t_<::ctb::utils::pack_indexing_t<I, Args...>>;
+    return static_cast<::ctb::tuple::details::tuple_element_impl_<I, type> const&>(self).val_;
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::padded_tuple<Args...>&& self) noexcept {
+    using type = ::ctb::tuple::details::unwrap_isolated_t_<::ctb::utils::pack_indexing_t<I, Args...>>;
+    return static_cast<type&&>(static_cast<::ctb::tuple::details::tuple_element_impl_<I, type>&>(self).val_);
+}
+
+template<::std::size_t I, typename... Args>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(::ctb::tuple::padded_tuple<Args...> const&& self) noexcept {
+    using type = ::ctb::tuple::details::unwrap_isolated_t_<::ctb::utils::pack_indexing_t<I, Args...>>;
+    return static_cast<type const&&>(
+        static_cast<::ctb::tuple::details::tuple_element_impl_<I, type> const&>(self).val_);
+}
+
+/* get padded_tuple field by type, the type must be unique
+ *
+ * Usage: get<std::uint64_t>(t)
+ */
+template<typename T, typename Self>
+    requires (is_padded_tuple<Self>)
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(Self&& self) noexcept {
+    static_assert(details::has_unique_element_<T, ::std::remove_cvref_t<Self>>,
+                  "ctb::tuple::TypeError: the type must appear exactly once");
+    return ::ctb::tuple::get<details::type_index_v_<T, ::std::remove_cvref_t<Self>>>(::std::forward<Self>(self));
+}
+
+} // namespace ctb::tuple
+
+template<::std::size_t I, typename... Args>
+struct std::tuple_element<I, ::ctb::tuple::padded_tuple<Args...>> {
+    using type = ::ctb::tuple::details::unwrap_isolated_t_<::ctb::utils::pack_indexing_t<I, Args...>>;
+};
+
+template<typename... Args>
+struct std::tuple_size<::ctb::tuple::padded_tuple<Args...>> {
+    static constexpr ::std::size_t value = sizeof...(Args);
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
 #include <utility>
 #include <type_traits>
 
@@ -32,17 +34,45 @@ namespace details {
 
 #if !defined(__cpp_pack_indexing) || __cpp_pack_indexing < 202311L
 
-template<::std::size_t I, typename First, typename... Rest>
-    requires (I <= sizeof...(Rest))
-struct pack_indexing_before_cxx26_ {
-    using type = typename ::ctb::utils::details::pack_indexing_before_cxx26_<I - 1, Rest...>::type;
+    #if defined(__has_builtin) && !defined(CTB_NO_TYPE_PACK_ELEMENT)
+        #if __has_builtin(__type_pack_element)
+            #define CTB_UTILS_TYPE_PACK_ELEMENT_
+        #endif
+    #endif
+
+/* Pack indexing in constant template depth
+ *
+ * __type_pack_element if the compiler has it (define CTB_NO_TYPE_PACK_ELEMENT
+ * to compare), otherwise overload resolution picks the base indexed_type_<I, T>
+ * of one class deriving from all of them, instead of recursing once per index.
+ */
+template<::std::size_t I, typename T>
+struct indexed_type_ {
+    using type = T;
 };
 
-template<typename First, typename... Rest>
-struct pack_indexing_before_cxx26_<0, First, Rest...> {
-    using type = First;
+template<typename Seq, typename... Args>
+struct indexed_types_;
+
+template<::std::size_t... I, typename... Args>
+struct indexed_types_<::std::index_sequence<I...>, Args...> : indexed_type_<I, Args>... {};
+
+template<::std::size_t I, typename T>
+indexed_type_<I, T> select_indexed_type_(indexed_type_<I, T> const&) noexcept;
+
+template<::std::size_t I, typename... Args>
+    requires (I < sizeof...(Args))
+struct pack_indexing_before_cxx26_ {
+    #if defined(CTB_UTILS_TYPE_PACK_ELEMENT_)
+    using type = __type_pack_element<I, Args...>;
+    #else
+    using type = typename decltype(::ctb::utils::details::select_indexed_type_<I>(
+        ::std::declval<indexed_types_<::std::index_sequence_for<Args...>, Args...>>()))::type;
+    #endif
 };
 
+    #undef CTB_UTILS_TYPE_PACK_ELEMENT_
+
 #endif // !defined(__cpp_pack_indexing) || __cpp_pack_indexing < 202311L
 
 template<::std::size_t I, typename... Args>
@@ -72,4 +102,34 @@ struct pass_type {
     using type = T;
 };
 
+/* Minimum offset between two objects to avoid false sharing
+ *
+ * ::std::hardware_destructive_interference_size depends on compiler flags
+ * (GCC warns about using it in headers), so it is fixed here.
+ */
+#if defined(__APPLE__) && defined(__aarch64__)
+inline constexpr ::std::size_t cache_line_size{128};
+#else
+inline constexpr ::std::size_t cache_line_size{64};
+#endif
+
+/* Reverse the bytes of an integer, same as C++23 ::std::byteswap
+ */
+template<::std::integral T>
+[[nodiscard]]
+constexpr T byteswap(T val) noexcept {
+    if constexpr (sizeof(T) == 1) {
+        return val;
+    } else {
+        using unsigned_type = ::std::make_unsigned_t<T>;
+        auto src = static_cast<unsigned_type>(val);
+        unsigned_type res{};
+        for (::std::size_t i{}; i < sizeof(T); ++i) {
+            res = static_cast<unsigned_type>((res << 8) | (src & 0xff));
+            src = static_cast<unsigned_type>(src >> 8);
+        }
+        return static_cast<T>(res);
+    }
+}
+
 } // namespace ctb::utils
@@ -0,0 +1,466 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exception.hh"
+#include "utils.hh"
+
+/* A tagged union of Ts..., like ::std::variant without the valueless state
+ *
+ * The alternatives live in a recursive union, the tag is the smallest
+ * unsigned type that counts them and is laid out in the tail padding of the
+ * union when no alternative reaches it, so variant<char[15] wrapper, long>
+ * takes 16 bytes. Copy, move and destruction are trivial when they are for
+ * every alternative, and visit is one indirect call through a table of one
+ * function per alternative.
+ *
+ * Usage: variant<int, double> v{1.};
+ *        visit([](auto x) { return static_cast<long>(x); }, v);
+ */
+namespace ctb::variant {
+
+namespace details {
+
+template<::std::size_t N>
+using index_type_t_ =
+    ::std::conditional_t<N <= ::std::numeric_limits<::std::uint8_t>::max(), ::std::uint8_t,
+                         ::std::conditional_t<N <= ::std::numeric_limits<::std::uint16_t>::max(), ::std::uint16_t,
+                                              ::std::uint32_t>>;
+
+struct variant_access_;
+
+/* tag of the constructor that leaves every alternative uninitialized
+ */
+struct uninitialized_t_ {};
+
+template<typename... Ts>
+union variadic_union_;
+
+template<>
+union variadic_union_<> {};
+
+/* The constructors make the union not a POD, so its tail padding may hold the tag
+ */
+template<typename T, typename... Rest>
+union variadic_union_<T, Rest...> {
+    T head_;
+    variadic_union_<Rest...> tail_;
+
+    constexpr variadic_union_(uninitialized_t_) noexcept {
+    }
+
+    template<typename... Args>
+    constexpr variadic_union_(::std::in_place_index_t<0>, Args&&... args) noexcept
+        : head_(::std::forward<Args>(args)...) {
+    }
+
+    template<::std::size_t I, typename... Args>
+        requires (I != 0)
+    constexpr variadic_union_(::std::in_place_index_t<I>, Args&&... args) noexcept
+        : tail_(::std::in_place_index<I - 1>, ::std::forward<Args>(args)...) {
+    }
+
+    constexpr ~variadic_union_() noexcept
+        requires (::std::is_trivially_destructible_v<T> && (::std::is_trivially_destructible_v<Rest> && ...))
+    = default;
+
+    /* the variant destroys the active alternative
+     */
+    constexpr ~variadic_union_() noexcept {
+    }
+};
+
+/* the alternative I of u
+ */
+template<::std::size_t I, typename Union>
+[[nodiscard]]
+constexpr auto&& get_alternative_(Union& u) noexcept {
+    if constexpr (I == 0) {
+        return u.head_;
+    } else {
+        return details::get_alternative_<I - 1>(u.tail_);
+    }
+}
+
+/* which special members of variant<Ts...> are defaulted, and so trivial
+ */
+template<typename... Ts>
+inline constexpr bool trivially_copyable_{(::std::is_trivially_copy_constructible_v<Ts> && ...)};
+
+template<typename... Ts>
+inline constexpr bool trivially_movable_{(::std::is_trivially_move_constructible_v<Ts> && ...)};
+
+template<typename... Ts>
+inline constexpr bool trivially_copy_assignable_{
+    ((::std::is_trivially_copy_constructible_v<Ts> && ::std::is_trivially_copy_assignable_v<Ts> &&
+      ::std::is_trivially_destructible_v<Ts>) &&
+     ...)};
+
+template<typename... Ts>
+inline constexpr bool trivially_move_assignable_{
+    ((::std::is_trivially_move_constructible_v<Ts> && ::std::is_trivially_move_assignable_v<Ts> &&
+      ::std::is_trivially_destructible_v<Ts>) &&
+     ...)};
+
+template<typename T, typename... Ts>
+inline constexpr ::std::size_t count_type_v_{(::std::size_t{::std::is_same_v<T, Ts>} + ... + 0)};
+
+/* index of T in Ts, sizeof...(Ts) if there is not
+ */
+template<typename T, typename... Ts>
+[[nodiscard]]
+consteval ::std::size_t type_index_() noexcept {
+    ::std::size_t i{}, res{sizeof...(Ts)};
+    static_cast<void>(((::std::is_same_v<T, Ts> ? (res = i, true) : (++i, false)) || ...));
+    return res;
+}
+
+} // namespace details
+
+template<typename... Ts>
+    requires (sizeof...(Ts) != 0 && ((::std::is_object_v<Ts> && !::std::is_array_v<Ts>) && ...))
+class variant {
+public:
+    using index_type = details::index_type_t_<sizeof...(Ts)>;
+    static constexpr ::std::size_t size{sizeof...(Ts)};
+
+private:
+    friend struct details::variant_access_;
+
+#if __has_cpp_attribute(msvc::no_unique_address)
+    [[msvc::no_unique_address]]
+#elif __has_cpp_attribute(no_unique_address)
+    [[no_unique_address]]
+#endif
+    details::variadic_union_<Ts...> storage_;
+    index_type index_;
+
+    /* construct the alternative of other that is active, storage_ must hold none
+     */
+    template<typename Other>
+    constexpr void construct_from_(Other&& other) noexcept {
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            static_cast<void>(((other.index_ == I ? (this->template construct_<I>(::ctb::utils::forward_like<Other>(
+                                                         details::get_alternative_<I>(other.storage_))),
+                                                     true)
+                                                  : false) ||
+                               ...));
+        }(::std::index_sequence_for<Ts...>{});
+    }
+
+    template<::std::size_t I, typename... Args>
+    constexpr void construct_(Args&&... args) noexcept {
+        ::std::construct_at(&details::get_alternative_<I>(this->storage_), ::std::forward<Args>(args)...);
+        this->index_ = static_cast<index_type>(I);
+    }
+
+    constexpr void destroy_() noexcept {
+        if constexpr (!(::std::is_trivially_destructible_v<Ts> && ...)) {
+            [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+                static_cast<void>(
+                    ((this->index_ == I ? (::std::destroy_at(&details::get_alternative_<I>(this->storage_)), true)
+                                        : false) ||
+                     ...));
+            }(::std::index_sequence_for<Ts...>{});
+        }
+    }
+
+public:
+    /* the first alternative, value-initialized
+     */
+    constexpr variant() noexcept
+        requires (::std::default_initializable<::ctb::utils::pack_indexing_t<0, Ts...>>)
+        : storage_{::std::in_place_index<0>},
+          index_{} {
+    }
+
+    /* the alternative of type exactly T, no conversion is considered
+     */
+    template<typename T>
+        requires (details::count_type_v_<::std::remove_cvref_t<T>, Ts...> == 1 &&
+                  ::std::constructible_from<::std::remove_cvref_t<T>, T &&>)
+    constexpr variant(T&& val) noexcept
+        : storage_{::std::in_place_index<details::type_index_<::std::remove_cvref_t<T>, Ts...>()>,
+                   ::std::forward<T>(val)},
+          index_{static_cast<index_type>(details::type_index_<::std::remove_cvref_t<T>, Ts...>())} {
+    }
+
+    template<::std::size_t I, typename... Args>
+        requires (I < sizeof...(Ts) && ::std::constructible_from<::ctb::utils::pack_indexing_t<I, Ts...>, Args && ...>)
+    constexpr explicit variant(::std::in_place_index_t<I>, Args&&... args) noexcept
+        : storage_{::std::in_place_index<I>, ::std::forward<Args>(args)...},
+          index_{static_cast<index_type>(I)} {
+    }
+
+    template<typename T, typename... Args>
+        requires (details::count_type_v_<T, Ts...> == 1 && ::std::constructible_from<T, Args && ...>)
+    constexpr explicit variant(::std::in_place_type_t<T>, Args&&... args) noexcept
+        : variant(::std::in_place_index<details::type_index_<T, Ts...>()>, ::std::forward<Args>(args)...) {
+    }
+
+    constexpr variant(variant const&) noexcept
+        requires (details::trivially_copyable_<Ts...>)
+    = default;
+
+    constexpr variant(variant const& other) noexcept
+        requires ((::std::is_copy_constructible_v<Ts> && ...) && !details::trivially_copyable_<Ts...>)
+        : storage_{details::uninitialized_t_{}},
+          index_{other.index_} {
+        this->construct_from_(other);
+    }
+
+    constexpr variant(variant&&) noexcept
+        requires (details::trivially_movable_<Ts...>)
+    = default;
+
+    constexpr variant(variant&& other) noexcept
+        requires ((::std::is_move_constructible_v<Ts> && ...) && !details::trivially_movable_<Ts...>)
+        : storage_{details::uninitialized_t_{}},
+          index_{other.index_} {
+        this->construct_from_(::std::move(other));
+    }
+
+    constexpr variant& operator=(variant const&) noexcept
+        requires (details::trivially_copy_assignable_<Ts...>)
+    = default;
+
+    /* the same alternative is assigned, another one is destroyed and the new one constructed
+     */
+    constexpr variant& operator=(variant const& other) noexcept
+        requires (((::std::is_copy_constructible_v<Ts> && ::std::is_copy_assignable_v<Ts>) && ...) &&
+                  !details::trivially_copy_assignable_<Ts...>)
+    {
+        this->assign_from_(other);
+        return *this;
+    }
+
+    constexpr variant& operator=(variant&&) noexcept
+        requires (details::trivially_move_assignable_<Ts...>)
+    = default;
+
+    constexpr variant& operator=(variant&& other) noexcept
+        requires (((::std::is_move_constructible_v<Ts> && ::std::is_move_assignable_v<Ts>) && ...) &&
+                  !details::trivially_move_assignable_<Ts...>)
+    {
+        this->assign_from_(::std::move(other));
+        return *this;
+    }
+
+    constexpr ~variant() noexcept
+        requires (::std::is_trivially_destructible_v<Ts> && ...)
+    = default;
+
+    constexpr ~variant() noexcept {
+        this->destroy_();
+    }
+
+    /* destroy the active alternative and construct the alternative I
+     */
+    template<::std::size_t I, typename... Args>
+        requires (I < sizeof...(Ts) && ::std::constructible_from<::ctb::utils::pack_indexing_t<I, Ts...>, Args && ...>)
+    constexpr auto& emplace(Args&&... args) noexcept {
+        this->destroy_();
+        this->template construct_<I>(::std::forward<Args>(args)...);
+        return details::get_alternative_<I>(this->storage_);
+    }
+
+    template<typename T, typename... Args>
+        requires (details::count_type_v_<T, Ts...> == 1 && ::std::constructible_from<T, Args && ...>)
+    constexpr T& emplace(Args&&... args) noexcept {
+        return this->template emplace<details::type_index_<T, Ts...>()>(::std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]]
+    constexpr ::std::size_t index() const noexcept {
+        return this->index_;
+    }
+
+private:
+    template<typename Other>
+    constexpr void assign_from_(Other&& other) noexcept {
+        if (this == &other) [[unlikely]] {
+            return;
+        }
+        if (this->index_ != other.index_) {
+            this->destroy_();
+            this->construct_from_(::std::forward<Other>(other));
+            return;
+        }
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            static_cast<void>(((this->index_ == I ? (details::get_alternative_<I>(this->storage_) =
+                                                         ::ctb::utils::forward_like<Other>(
+                                                             details::get_alternative_<I>(other.storage_)),
+                                                     true)
+                                                  : false) ||
+                               ...));
+        }(::std::index_sequence_for<Ts...>{});
+    }
+};
+
+namespace details {
+
+/* the free functions reach the alternatives through here, the members stay private
+ */
+struct variant_access_ {
+    template<::std::size_t I, typename Variant>
+    [[nodiscard]]
+    static constexpr auto&& get_(Variant& v) noexcept {
+        return details::get_alternative_<I>(v.storage_);
+    }
+};
+
+template<typename T>
+constexpr bool is_variant_ = false;
+
+template<typename... Ts>
+constexpr bool is_variant_<variant<Ts...>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_variant = details::is_variant_<::std::remove_cvref_t<T>>;
+
+/* the alternative I, which must be the active one
+ *
+ * Usage: get<1>(v)
+ */
+template<::std::size_t I, is_variant Variant>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(Variant&& v) noexcept {
+    static_assert(I < ::std::remove_cvref_t<Variant>::size, "ctb::variant::IndexError: index out of range");
+    exception::assert_true(v.index() == I);
+    return ::ctb::utils::forward_like<Variant>(details::variant_access_::get_<I>(v));
+}
+
+/* the alternative of type T, which must be the active one
+ *
+ * Usage: get<double>(v)
+ */
+template<typename T, is_variant Variant>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto&& get(Variant&& v) noexcept {
+    constexpr auto index = []<typename... Ts>(::ctb::utils::pass_type<variant<Ts...>>) {
+        static_assert(details::count_type_v_<T, Ts...> == 1,
+                      "ctb::variant::TypeError: the type must appear exactly once");
+        return details::type_index_<T, Ts...>();
+    }(::ctb::utils::pass_type<::std::remove_cvref_t<Variant>>{});
+    return ::ctb::variant::get<index>(::std::forward<Variant>(v));
+}
+
+/* pointer to the alternative I, nullptr if it is not the active one
+ */
+template<::std::size_t I, typename... Ts>
+[[nodiscard]]
+constexpr auto* get_if(variant<Ts...>* v) noexcept {
+    static_assert(I < sizeof...(Ts), "ctb::variant::IndexError: index out of range");
+    return v != nullptr && v->index() == I ? &details::variant_access_::get_<I>(*v) : nullptr;
+}
+
+template<::std::size_t I, typename... Ts>
+[[nodiscard]]
+constexpr auto const* get_if(variant<Ts...> const* v) noexcept {
+    static_assert(I < sizeof...(Ts), "ctb::variant::IndexError: index out of range");
+    return v != nullptr && v->index() == I ? &details::variant_access_::get_<I>(*v) : nullptr;
+}
+
+template<typename T, typename... Ts>
+[[nodiscard]]
+constexpr bool holds_alternative(variant<Ts...> const& v) noexcept {
+    static_assert(details::count_type_v_<T, Ts...> == 1, "ctb::variant::TypeError: the type must appear exactly once");
+    return v.index() == details::type_index_<T, Ts...>();
+}
+
+namespace details {
+
+template<typename Variant, typename Visitor, ::std::size_t I>
+using visit_result_ = ::std::invoke_result_t<
+    Visitor, decltype(::ctb::utils::forward_like<Variant>(
+                 details::variant_access_::get_<I>(::std::declval<::std::remove_reference_t<Variant>&>())))>;
+
+template<typename Variant, typename Visitor, ::std::size_t... I>
+[[nodiscard]]
+consteval auto get_visit_result_(::std::index_sequence<I...>) noexcept {
+    if constexpr ((::std::is_void_v<visit_result_<Variant, Visitor, I>> && ...)) {
+        return ::ctb::utils::pass_type<void>{};
+    } else {
+        return ::ctb::utils::pass_type<::std::common_type_t<visit_result_<Variant, Visitor, I>...>>{};
+    }
+}
+
+template<typename Variant, typename Visitor>
+using visit_result_t_ = typename decltype(details::get_visit_result_<Variant, Visitor>(
+    ::std::make_index_sequence<::std::remove_cvref_t<Variant>::size>{}))::type;
+
+/* one function per alternative, a static table so it lives in .rodata
+ */
+template<typename Variant, typename Visitor, ::std::size_t... I>
+[[nodiscard]]
+consteval auto make_visit_table_(::std::index_sequence<I...>) noexcept {
+    using variant_type = ::std::remove_reference_t<Variant>;
+    using visitor_type = ::std::remove_reference_t<Visitor>;
+    using result_type = details::visit_result_t_<Variant, Visitor>;
+    using fn_type = result_type (*)(visitor_type*, variant_type*);
+    return ::std::array<fn_type, sizeof...(I)>{+[](visitor_type* f, variant_type* v) {
+        return static_cast<result_type>(static_cast<Visitor&&>(*f)(
+            ::ctb::utils::forward_like<Variant>(details::variant_access_::get_<I>(*v))));
+    }...};
+}
+
+template<typename Variant, typename Visitor>
+inline constexpr auto visit_table_{details::make_visit_table_<Variant, Visitor>(
+    ::std::make_index_sequence<::std::remove_cvref_t<Variant>::size>{})};
+
+} // namespace details
+
+/* Call visitor with the active alternative of v
+ *
+ * One indirect call through a table indexed by the tag. Returns void if
+ * visitor returns void for every alternative, else the common type of its
+ * results.
+ */
+template<typename Visitor, is_variant Variant>
+constexpr details::visit_result_t_<Variant&&, Visitor&&> visit(Visitor&& visitor, Variant&& v) noexcept {
+    constexpr auto const& table = details::visit_table_<Variant&&, Visitor&&>;
+    exception::assert_true(v.index() < table.size());
+    return table[v.index()](&visitor, &v);
+}
+
+template<typename... Ts>
+    requires requires(Ts const&... val) { ((val == val) && ...); }
+[[nodiscard]]
+constexpr bool operator==(variant<Ts...> const& lhs, variant<Ts...> const& rhs) noexcept {
+    if (lhs.index() != rhs.index()) {
+        return false;
+    }
+    return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+        bool res{};
+        static_cast<void>(((lhs.index() == I ? (res = details::variant_access_::get_<I>(lhs) ==
+                                                     details::variant_access_::get_<I>(rhs),
+                                               true)
+                                            : false) ||
+                           ...));
+        return res;
+    }(::std::index_sequence_for<Ts...>{});
+}
+
+} // namespace ctb::variant
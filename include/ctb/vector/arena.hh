@@ -0,0 +1,255 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../vector.hh"
+
+#ifndef CTB_N_STL_SUPPORT
+    #if __has_include(<memory_resource>)
+        #include <memory_resource>
+    #endif
+#endif // !defined(CTB_N_STL_SUPPORT)
+
+namespace ctb::vector {
+
+namespace details {
+
+template<len_type_ Align>
+concept is_alignment_ = Align > 0 && (Align & (Align - 1)) == 0;
+
+} // namespace details
+
+/* A bump allocator over an inline buffer
+ *
+ * Allocation only moves a cursor, reset() releases everything at once.
+ * Destructors of objects created in an arena are NOT called by reset().
+ */
+template<len_type_ Bytes, len_type_ Align = alignof(::std::max_align_t)>
+    requires (Bytes > 0 && details::is_alignment_<Align>)
+class arena {
+    alignas(Align) ::ctb::vector::vector<::std::byte, Bytes> buf_{};
+    len_type_ used_{};
+
+public:
+    constexpr arena() noexcept = default;
+    constexpr ~arena() noexcept = default;
+    arena(arena const&) = delete;
+    arena& operator=(arena const&) = delete;
+
+    /* nullptr if there is not enough space left
+     */
+    [[nodiscard]]
+    void* allocate(len_type_ bytes, len_type_ align = alignof(::std::max_align_t)) noexcept {
+        exception::assert_true(align > 0 && (align & (align - 1)) == 0);
+        auto const cursor = reinterpret_cast<::std::uintptr_t>(this->buf_.arr) + this->used_;
+        // offsets from the buffer never wrap, unlike addresses rounded up or adding bytes
+        auto const padding = static_cast<len_type_>(-cursor & (static_cast<::std::uintptr_t>(align) - 1));
+        if (padding > Bytes - this->used_ || bytes > Bytes - this->used_ - padding) [[unlikely]] {
+            return nullptr;
+        }
+        auto const start = this->used_ + padding;
+        this->used_ = start + bytes;
+        return this->buf_.arr + start;
+    }
+
+    /* Only the latest allocation is actually given back,
+     * everything else is released by reset().
+     */
+    void deallocate(void* ptr, len_type_ bytes, [[maybe_unused]] len_type_ align = 0) noexcept {
+        if (static_cast<::std::byte*>(ptr) + bytes == this->buf_.arr + this->used_) {
+            this->used_ -= bytes;
+        }
+    }
+
+    template<typename T, typename... Args>
+    [[nodiscard]]
+    T* create(Args&&... args) noexcept {
+        auto* ptr = this->allocate(sizeof(T), alignof(T));
+        if (ptr == nullptr) [[unlikely]] {
+            return nullptr;
+        }
+        return ::new (ptr) T(::std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        this->used_ = 0;
+    }
+
+    [[nodiscard]]
+    bool owns(void const* ptr) const noexcept {
+        auto const p = reinterpret_cast<::std::uintptr_t>(ptr);
+        auto const base = reinterpret_cast<::std::uintptr_t>(this->buf_.arr);
+        return p >= base && p < base + Bytes;
+    }
+
+    [[nodiscard]]
+    len_type_ used() const noexcept {
+        return this->used_;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ capacity() noexcept {
+        return Bytes;
+    }
+};
+
+/* A fixed-capacity object pool with an intrusive free list
+ *
+ * Free slots store the index of the next free slot, slots that were never
+ * used are handed out by a bump index, so construction is O(1) as well.
+ */
+template<typename T, len_type_ Cap>
+    requires (Cap > 0)
+class pool {
+    static constexpr len_type_ npos_{Cap};
+
+    static constexpr len_type_ slot_size_{sizeof(T) > sizeof(len_type_) ? sizeof(T) : sizeof(len_type_)};
+
+    struct slot_ {
+        alignas(T) alignas(len_type_) ::std::byte storage_[slot_size_];
+    };
+
+    ::ctb::vector::vector<slot_, Cap> slots_{};
+    len_type_ free_head_{npos_};
+    len_type_ bump_{};
+    len_type_ size_{};
+
+    [[nodiscard]]
+    len_type_ index_of_(void const* ptr) const noexcept {
+        auto const offset =
+            reinterpret_cast<::std::uintptr_t>(ptr) - reinterpret_cast<::std::uintptr_t>(this->slots_.arr);
+        return static_cast<len_type_>(offset / sizeof(slot_));
+    }
+
+public:
+    using value_type = T;
+
+    constexpr pool() noexcept = default;
+    constexpr ~pool() noexcept = default;
+    pool(pool const&) = delete;
+    pool& operator=(pool const&) = delete;
+
+    /* Uninitialized storage for one T, nullptr if the pool is exhausted
+     */
+    [[nodiscard]]
+    T* allocate() noexcept {
+        len_type_ idx{};
+        if (this->free_head_ != npos_) {
+            idx = this->free_head_;
+            ::std::memcpy(&this->free_head_, this->slots_.arr[idx].storage_, sizeof(len_type_));
+        } else if (this->bump_ != Cap) {
+            idx = this->bump_++;
+        } else [[unlikely]] {
+            return nullptr;
+        }
+        ++this->size_;
+        return reinterpret_cast<T*>(this->slots_.arr[idx].storage_);
+    }
+
+    void deallocate(T* ptr) noexcept {
+        exception::assert_true(this->owns(ptr));
+        auto const idx = this->index_of_(ptr);
+        ::std::memcpy(this->slots_.arr[idx].storage_, &this->free_head_, sizeof(len_type_));
+        this->free_head_ = idx;
+        --this->size_;
+    }
+
+    template<typename... Args>
+    [[nodiscard]]
+    T* create(Args&&... args) noexcept {
+        auto* ptr = this->allocate();
+        if (ptr == nullptr) [[unlikely]] {
+            return nullptr;
+        }
+        return ::new (static_cast<void*>(ptr)) T(::std::forward<Args>(args)...);
+    }
+
+    void destroy(T* ptr) noexcept {
+        ::std::destroy_at(ptr);
+        this->deallocate(ptr);
+    }
+
+    /* Raw interface used by memory_resource, requests that do not fit in a slot fail
+     */
+    [[nodiscard]]
+    void* allocate(len_type_ bytes, len_type_ align) noexcept {
+        if (bytes > sizeof(T) || align > alignof(slot_)) {
+            return nullptr;
+        }
+        return this->allocate();
+    }
+
+    void deallocate(void* ptr, [[maybe_unused]] len_type_ bytes, [[maybe_unused]] len_type_ align) noexcept {
+        this->deallocate(static_cast<T*>(ptr));
+    }
+
+    [[nodiscard]]
+    bool owns(void const* ptr) const noexcept {
+        auto const p = reinterpret_cast<::std::uintptr_t>(ptr);
+        auto const base = reinterpret_cast<::std::uintptr_t>(this->slots_.arr);
+        return p >= base && p < base + sizeof(slot_) * Cap && (p - base) % sizeof(slot_) == 0;
+    }
+
+    [[nodiscard]]
+    len_type_ size() const noexcept {
+        return this->size_;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ capacity() noexcept {
+        return Cap;
+    }
+};
+
+#if !defined(CTB_N_STL_SUPPORT) && defined(__cpp_lib_memory_resource)
+
+/* Expose an arena or a pool as a ::std::pmr::memory_resource
+ *
+ * Requests the allocator can not serve go to upstream.
+ */
+template<typename Allocator>
+class memory_resource : public ::std::pmr::memory_resource {
+    Allocator& alloc_;
+    ::std::pmr::memory_resource* upstream_;
+
+    void* do_allocate(::std::size_t bytes, ::std::size_t align) override {
+        if (auto* ptr = this->alloc_.allocate(bytes, align); ptr != nullptr) [[likely]] {
+            return ptr;
+        }
+        return this->upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* ptr, ::std::size_t bytes, ::std::size_t align) override {
+        if (this->alloc_.owns(ptr)) [[likely]] {
+            this->alloc_.deallocate(ptr, bytes, align);
+        } else {
+            this->upstream_->deallocate(ptr, bytes, align);
+        }
+    }
+
+    [[nodiscard]]
+    bool do_is_equal(::std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    explicit memory_resource(Allocator& alloc,
+                             ::std::pmr::memory_resource* upstream = ::std::pmr::get_default_resource()) noexcept
+        : alloc_{alloc},
+          upstream_{upstream} {
+    }
+};
+
+#endif // !defined(CTB_N_STL_SUPPORT) && defined(__cpp_lib_memory_resource)
+
+} // namespace ctb::vector
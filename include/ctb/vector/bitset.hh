@@ -0,0 +1,262 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "../exception.hh"
+#include "../string.hh"
+#include "../vector.hh"
+
+namespace ctb::vector {
+
+/* A fixed-size bitset packed in 64-bit words
+ *
+ * Unlike ::std::bitset, it is a structural type, so it can be used as a
+ * template parameter and is fully usable in constant expressions.
+ *
+ * Bits beyond N in the last word are always zero.
+ */
+template<len_type_ N>
+struct bitset {
+    static_assert(N > 0);
+
+    using word_type = ::std::uint64_t;
+    static constexpr len_type_ word_bits{64};
+    static constexpr len_type_ word_count{(N + word_bits - 1) / word_bits};
+    /* returned by find_first/find_next if there is no more set bit
+     */
+    static constexpr len_type_ npos{N};
+
+    ::ctb::vector::vector<word_type, word_count> words{};
+
+    constexpr bitset() noexcept = default;
+    constexpr ~bitset() noexcept = default;
+
+    /* Usage: bitset<128>{{1, 5, 64}}
+     */
+    template<len_type_ M>
+    constexpr bitset(len_type_ const (&indices)[M]) noexcept {
+        for (auto i : indices) {
+            this->set(i);
+        }
+    }
+
+    /* Set bits of every character (as its code unit) in chars
+     */
+    template<string::is_char Char, len_type_ M>
+    constexpr bitset(string::string<Char, M> const& chars) noexcept {
+        for (auto ch : chars) {
+            this->set(static_cast<len_type_>(static_cast<::std::make_unsigned_t<Char>>(ch)));
+        }
+    }
+
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    constexpr bool test(len_type_ i) const noexcept {
+        exception::assert_true(i < N);
+        return (this->words.arr[i / word_bits] >> (i % word_bits)) & 1u;
+    }
+
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bitset& set(len_type_ i) noexcept {
+        exception::assert_true(i < N);
+        this->words.arr[i / word_bits] |= word_type{1} << (i % word_bits);
+        return *this;
+    }
+
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bitset& reset(len_type_ i) noexcept {
+        exception::assert_true(i < N);
+        this->words.arr[i / word_bits] &= ~(word_type{1} << (i % word_bits));
+        return *this;
+    }
+
+    [[nodiscard]]
+    constexpr len_type_ popcount() const noexcept {
+        len_type_ res{};
+        for (len_type_ i{}; i < word_count; ++i) {
+            res += static_cast<len_type_>(::std::popcount(this->words.arr[i]));
+        }
+        return res;
+    }
+
+    [[nodiscard]]
+    constexpr bool any() const noexcept {
+        word_type res{};
+        for (len_type_ i{}; i < word_count; ++i) {
+            res |= this->words.arr[i];
+        }
+        return res != 0;
+    }
+
+    [[nodiscard]]
+    constexpr bool none() const noexcept {
+        return !this->any();
+    }
+
+    /* Index of the first set bit at or after pos, npos if there is none
+     */
+    [[nodiscard]]
+    constexpr len_type_ find_next(len_type_ pos) const noexcept {
+        if (pos >= N) {
+            return npos;
+        }
+        len_type_ w{pos / word_bits};
+        word_type cur = this->words.arr[w] & (~word_type{} << (pos % word_bits));
+        while (cur == 0) {
+            if (++w == word_count) {
+                return npos;
+            }
+            cur = this->words.arr[w];
+        }
+        return w * word_bits + static_cast<len_type_>(::std::countr_zero(cur));
+    }
+
+    [[nodiscard]]
+    constexpr len_type_ find_first() const noexcept {
+        return this->find_next(0);
+    }
+
+    class iterator {
+        bitset const* self_;
+        len_type_ w_;
+        word_type cur_;
+
+        constexpr void skip_empty_() noexcept {
+            while (this->cur_ == 0) {
+                if (++this->w_ >= word_count) {
+                    this->w_ = word_count;
+                    return;
+                }
+                this->cur_ = this->self_->words.arr[this->w_];
+            }
+        }
+
+    public:
+        using value_type = len_type_;
+        using difference_type = ::std::ptrdiff_t;
+
+        constexpr iterator() noexcept = default;
+
+        constexpr iterator(bitset const* self, len_type_ w) noexcept
+            : self_{self},
+              w_{w},
+              cur_{w < word_count ? self->words.arr[w] : 0} {
+            this->skip_empty_();
+        }
+
+        [[nodiscard]]
+        constexpr len_type_ operator*() const noexcept {
+            return this->w_ * word_bits + static_cast<len_type_>(::std::countr_zero(this->cur_));
+        }
+
+        constexpr iterator& operator++() noexcept {
+            this->cur_ &= this->cur_ - 1;
+            this->skip_empty_();
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        [[nodiscard]]
+        constexpr bool operator==(iterator const& other) const noexcept {
+            return this->w_ == other.w_ && this->cur_ == other.cur_;
+        }
+    };
+
+    /* Iterate indices of set bits in increasing order
+     */
+    [[nodiscard]]
+    constexpr iterator begin() const noexcept {
+        return iterator{this, 0};
+    }
+
+    [[nodiscard]]
+    constexpr iterator end() const noexcept {
+        return iterator{this, word_count};
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(bitset const& other) const noexcept {
+        for (len_type_ i{}; i < word_count; ++i) {
+            if (this->words.arr[i] != other.words.arr[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ size() noexcept {
+        return N;
+    }
+};
+
+namespace details {
+
+template<len_type_ N, typename Op>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr bitset<N> bitwise_(bitset<N> const& lhs, bitset<N> const& rhs, Op op) noexcept {
+    bitset<N> res{};
+    // fixed trip count over plain arrays, compilers turn it into SIMD
+    for (len_type_ i{}; i < bitset<N>::word_count; ++i) {
+        res.words.arr[i] = op(lhs.words.arr[i], rhs.words.arr[i]);
+    }
+    return res;
+}
+
+} // namespace details
+
+template<len_type_ N>
+[[nodiscard]]
+constexpr bitset<N> operator&(bitset<N> const& lhs, bitset<N> const& rhs) noexcept {
+    return details::bitwise_(lhs, rhs, [](auto a, auto b) { return a & b; });
+}
+
+template<len_type_ N>
+[[nodiscard]]
+constexpr bitset<N> operator|(bitset<N> const& lhs, bitset<N> const& rhs) noexcept {
+    return details::bitwise_(lhs, rhs, [](auto a, auto b) { return a | b; });
+}
+
+template<len_type_ N>
+[[nodiscard]]
+constexpr bitset<N> operator^(bitset<N> const& lhs, bitset<N> const& rhs) noexcept {
+    return details::bitwise_(lhs, rhs, [](auto a, auto b) { return a ^ b; });
+}
+
+/* lhs & ~rhs
+ */
+template<len_type_ N>
+[[nodiscard]]
+constexpr bitset<N> andnot(bitset<N> const& lhs, bitset<N> const& rhs) noexcept {
+    return details::bitwise_(lhs, rhs, [](auto a, auto b) { return a & ~b; });
+}
+
+} // namespace ctb::vector
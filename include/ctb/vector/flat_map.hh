@@ -0,0 +1,143 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../vector.hh"
+
+namespace ctb::vector {
+
+namespace details {
+
+template<typename K>
+concept is_flat_map_key_ = ::std::integral<K> || ::std::is_enum_v<K>;
+
+template<typename K, typename V, len_type_ N>
+consteval void eytzinger_fill_(::std::pair<K, V> const (&sorted)[N], K* keys, V* values, len_type_& i,
+                               len_type_ k) noexcept {
+    if (k > N) {
+        return;
+    }
+    ::ctb::vector::details::eytzinger_fill_(sorted, keys, values, i, 2 * k);
+    keys[k] = sorted[i].first;
+    values[k] = sorted[i].second;
+    ++i;
+    ::ctb::vector::details::eytzinger_fill_(sorted, keys, values, i, 2 * k + 1);
+}
+
+template<typename T>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+constexpr void prefetch_([[maybe_unused]] T const* ptr) noexcept {
+#if defined(__has_builtin)
+    #if __has_builtin(__builtin_prefetch)
+    if (!::std::is_constant_evaluated()) {
+        __builtin_prefetch(ptr);
+    }
+    #endif
+#endif
+}
+
+} // namespace details
+
+/* A read-only map of integer or enum keys built at compile time
+ *
+ * Entries are sorted in consteval and stored in Eytzinger (BFS) order, with keys
+ * and values in separate vectors. A lookup walks down the implicit tree with a
+ * branchless step, and the first levels are packed together in the same cache lines.
+ *
+ * keys[0] and values[0] are unused, the root is at index 1.
+ */
+template<details::is_flat_map_key_ K, typename V, len_type_ N>
+struct flat_map {
+    static_assert(N > 0);
+
+    using key_type = K;
+    using mapped_type = V;
+
+    ::ctb::vector::vector<K, N + 1> keys{};
+    ::ctb::vector::vector<V, N + 1> values{};
+
+    /* Duplicated keys are rejected at compile time.
+     */
+    consteval flat_map(::std::pair<K, V> const (&entries)[N]) noexcept {
+        ::std::pair<K, V> sorted[N]{};
+        ::std::copy(entries, entries + N, sorted);
+        ::std::sort(sorted, sorted + N, [](auto const& lhs, auto const& rhs) {
+            return lhs.first < rhs.first;
+        });
+        for (len_type_ i{1}; i < N; ++i) {
+            // ctb::vector::KeyError: duplicated key
+            exception::assert_false(sorted[i - 1].first == sorted[i].first);
+        }
+
+        len_type_ i{};
+        details::eytzinger_fill_(sorted, this->keys.arr, this->values.arr, i, 1);
+    }
+
+    constexpr ~flat_map() noexcept = default;
+
+    /* Index (in keys/values) of key, 0 if it is not found
+     */
+    [[nodiscard]]
+    constexpr len_type_ index_of(K key) const noexcept {
+        // keys that fit in one cache line, prefetching k * stride fetches the
+        // node 4 levels (for 4-byte keys) below
+        constexpr len_type_ stride = 64 / sizeof(K) > 0 ? 64 / sizeof(K) : 1;
+
+        len_type_ k{1};
+        while (k <= N) {
+            details::prefetch_(this->keys.arr + (k * stride <= N ? k * stride : 0));
+            k = 2 * k + static_cast<len_type_>(this->keys.arr[k] < key);
+        }
+        // cancel the right turns after the last left turn, which leads to the lower bound
+        k >>= ::std::countr_one(k) + 1;
+        return k != 0 && this->keys.arr[k] == key ? k : 0;
+    }
+
+    [[nodiscard]]
+    constexpr bool contains(K key) const noexcept {
+        return this->index_of(key) != 0;
+    }
+
+    [[nodiscard]]
+    constexpr exception::optional<V> find(K key) const noexcept {
+        if (auto const k = this->index_of(key); k != 0) {
+            return this->values.arr[k];
+        }
+        return exception::nullopt;
+    }
+
+    /* Same as find(key).value(), but without optional
+     */
+    [[nodiscard]]
+    constexpr V const& at(K key) const noexcept {
+        auto const k = this->index_of(key);
+        exception::assert_true(k != 0);
+        return this->values.arr[k];
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ size() noexcept {
+        return N;
+    }
+};
+
+template<details::is_flat_map_key_ K, typename V, len_type_ N>
+[[nodiscard]]
+consteval auto make_flat_map(::std::pair<K, V> const (&entries)[N]) noexcept {
+    return flat_map<K, V, N>{entries};
+}
+
+} // namespace ctb::vector
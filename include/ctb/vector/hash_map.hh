@@ -0,0 +1,286 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../vector.hh"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CTB_VECTOR_HASH_MAP_SSE2_
+#endif
+
+namespace ctb::vector {
+
+/* Default hasher of inline_hash_map, usable in constant expressions
+ *
+ * Integers and enums are mixed with the splitmix64 finalizer, other key types
+ * need a user-provided hasher.
+ */
+template<typename K>
+struct hash;
+
+template<typename K>
+    requires (::std::integral<K> || ::std::is_enum_v<K>)
+struct hash<K> {
+    [[nodiscard]]
+    constexpr ::std::uint64_t operator()(K key) const noexcept {
+        auto x = static_cast<::std::uint64_t>(key);
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9u;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebu;
+        x ^= x >> 31;
+        return x;
+    }
+};
+
+namespace details {
+
+inline constexpr len_type_ group_size_{16};
+inline constexpr ::std::int8_t ctrl_empty_{-128};
+inline constexpr ::std::int8_t ctrl_deleted_{-2};
+
+/* Bitmask of control bytes in a group which satisfy a condition,
+ * bit i is slot i of the group.
+ */
+template<typename Pred>
+[[nodiscard]]
+constexpr ::std::uint32_t group_match_scalar_(::std::int8_t const* group, Pred pred) noexcept {
+    ::std::uint32_t res{};
+    for (len_type_ i{}; i < group_size_; ++i) {
+        res |= static_cast<::std::uint32_t>(pred(group[i])) << i;
+    }
+    return res;
+}
+
+[[nodiscard]]
+constexpr ::std::uint32_t group_match_(::std::int8_t const* group, ::std::int8_t h2) noexcept {
+#ifdef CTB_VECTOR_HASH_MAP_SSE2_
+    if (!::std::is_constant_evaluated()) {
+        auto const ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(group));
+        return static_cast<::std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+#endif
+    return details::group_match_scalar_(group, [h2](::std::int8_t c) { return c == h2; });
+}
+
+[[nodiscard]]
+constexpr ::std::uint32_t group_match_empty_(::std::int8_t const* group) noexcept {
+    return details::group_match_(group, details::ctrl_empty_);
+}
+
+/* empty and deleted are the only negative control bytes
+ */
+[[nodiscard]]
+constexpr ::std::uint32_t group_match_free_(::std::int8_t const* group) noexcept {
+#ifdef CTB_VECTOR_HASH_MAP_SSE2_
+    if (!::std::is_constant_evaluated()) {
+        auto const ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(group));
+        return static_cast<::std::uint32_t>(_mm_movemask_epi8(ctrl));
+    }
+#endif
+    return details::group_match_scalar_(group, [](::std::int8_t c) { return c < 0; });
+}
+
+} // namespace details
+
+/* An open-addressing hash map with inline storage (no heap)
+ *
+ * Follows the Swiss table design: one control byte per slot holds 7 bits of
+ * the hash (or empty/deleted), and a whole group of 16 control bytes is
+ * matched at once (with SSE2 at runtime). Probing moves group by group
+ * (triangular sequence), so a lookup visits at most Cap / 16 groups.
+ *
+ * Cap must be a power of two and a multiple of 16. Keys and values must be
+ * default constructible since they live in ctb::vector.
+ */
+template<typename K, typename V, len_type_ Cap, typename Hash = ::ctb::vector::hash<K>>
+    requires (Cap >= details::group_size_ && (Cap & (Cap - 1)) == 0 && ::std::is_default_constructible_v<K> &&
+              ::std::is_default_constructible_v<V>)
+class inline_hash_map {
+    static constexpr len_type_ group_count_{Cap / details::group_size_};
+    static constexpr len_type_ npos_{Cap};
+
+    ::ctb::vector::vector<::std::int8_t, Cap> ctrl_{};
+    ::ctb::vector::vector<K, Cap> keys_{};
+    ::ctb::vector::vector<V, Cap> values_{};
+    len_type_ size_{};
+
+    /* Calls f(group_begin) for each group of the probe sequence of hash,
+     * stops when f returns true.
+     */
+    template<typename F>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    static constexpr void probe_(::std::uint64_t hash, F&& f) noexcept {
+        auto g = static_cast<len_type_>(hash >> 7) & (group_count_ - 1);
+        for (len_type_ i{}; i < group_count_; ++i) {
+            if (f(g * details::group_size_)) {
+                return;
+            }
+            g = (g + i + 1) & (group_count_ - 1);
+        }
+    }
+
+    [[nodiscard]]
+    static constexpr ::std::int8_t h2_(::std::uint64_t hash) noexcept {
+        return static_cast<::std::int8_t>(hash & 0x7f);
+    }
+
+    [[nodiscard]]
+    constexpr len_type_ find_index_(K const& key, ::std::uint64_t hash) const noexcept {
+        auto res = npos_;
+        inline_hash_map::probe_(hash, [&](len_type_ base) {
+            auto const* group = this->ctrl_.arr + base;
+            for (auto m = details::group_match_(group, inline_hash_map::h2_(hash)); m != 0; m &= m - 1) {
+                auto const idx = base + static_cast<len_type_>(::std::countr_zero(m));
+                if (this->keys_.arr[idx] == key) {
+                    res = idx;
+                    return true;
+                }
+            }
+            return details::group_match_empty_(group) != 0;
+        });
+        return res;
+    }
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    constexpr inline_hash_map() noexcept {
+        for (auto& c : this->ctrl_.arr) {
+            c = details::ctrl_empty_;
+        }
+    }
+
+    constexpr ~inline_hash_map() noexcept = default;
+
+    /* nullptr if key is not found
+     */
+    [[nodiscard]]
+    constexpr V* find(K const& key) noexcept {
+        auto const idx = this->find_index_(key, Hash{}(key));
+        return idx == npos_ ? nullptr : this->values_.arr + idx;
+    }
+
+    [[nodiscard]]
+    constexpr V const* find(K const& key) const noexcept {
+        auto const idx = this->find_index_(key, Hash{}(key));
+        return idx == npos_ ? nullptr : this->values_.arr + idx;
+    }
+
+    [[nodiscard]]
+    constexpr bool contains(K const& key) const noexcept {
+        return this->find(key) != nullptr;
+    }
+
+    /* Insert key if it is absent, returns a pointer to the value of key
+     * (new or existing), or nullptr if the map is full.
+     */
+    template<typename U>
+        requires (::std::is_assignable_v<V&, U &&>)
+    constexpr V* try_emplace(K const& key, U&& value) noexcept {
+        auto const hash = Hash{}(key);
+        if (auto const idx = this->find_index_(key, hash); idx != npos_) {
+            return this->values_.arr + idx;
+        }
+
+        auto slot = npos_;
+        inline_hash_map::probe_(hash, [&](len_type_ base) {
+            if (auto const m = details::group_match_free_(this->ctrl_.arr + base); m != 0) {
+                slot = base + static_cast<len_type_>(::std::countr_zero(m));
+                return true;
+            }
+            return false;
+        });
+        if (slot == npos_) [[unlikely]] {
+            return nullptr;
+        }
+
+        this->ctrl_.arr[slot] = inline_hash_map::h2_(hash);
+        this->keys_.arr[slot] = key;
+        this->values_.arr[slot] = ::std::forward<U>(value);
+        ++this->size_;
+        return this->values_.arr + slot;
+    }
+
+    /* false if key already exists or the map is full
+     */
+    template<typename U>
+        requires (::std::is_assignable_v<V&, U &&>)
+    constexpr bool insert(K const& key, U&& value) noexcept {
+        auto const old_size = this->size_;
+        this->try_emplace(key, ::std::forward<U>(value));
+        return this->size_ != old_size;
+    }
+
+    /* false only if the map is full
+     */
+    template<typename U>
+        requires (::std::is_assignable_v<V&, U &&>)
+    constexpr bool insert_or_assign(K const& key, U&& value) noexcept {
+        if (auto* val = this->find(key); val != nullptr) {
+            *val = ::std::forward<U>(value);
+            return true;
+        }
+        return this->try_emplace(key, ::std::forward<U>(value)) != nullptr;
+    }
+
+    constexpr bool erase(K const& key) noexcept {
+        auto const idx = this->find_index_(key, Hash{}(key));
+        if (idx == npos_) {
+            return false;
+        }
+        // no probe sequence went past a group that still has an empty slot,
+        // so the slot can become empty instead of a tombstone
+        auto const* group = this->ctrl_.arr + idx / details::group_size_ * details::group_size_;
+        this->ctrl_.arr[idx] = details::group_match_empty_(group) != 0 ? details::ctrl_empty_ : details::ctrl_deleted_;
+        this->keys_.arr[idx] = K{};
+        this->values_.arr[idx] = V{};
+        --this->size_;
+        return true;
+    }
+
+    /* Visit every (key, value), in storage order
+     */
+    template<typename F>
+    constexpr void for_each(F&& f) const noexcept {
+        for (len_type_ i{}; i < Cap; ++i) {
+            if (this->ctrl_.arr[i] >= 0) {
+                f(this->keys_.arr[i], this->values_.arr[i]);
+            }
+        }
+    }
+
+    [[nodiscard]]
+    constexpr len_type_ size() const noexcept {
+        return this->size_;
+    }
+
+    [[nodiscard]]
+    constexpr bool empty() const noexcept {
+        return this->size_ == 0;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ capacity() noexcept {
+        return Cap;
+    }
+};
+
+} // namespace ctb::vector
+
+#undef CTB_VECTOR_HASH_MAP_SSE2_
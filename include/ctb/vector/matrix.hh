@@ -0,0 +1,328 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <cstddef>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "../exception.hh"
+#include "../vector.hh"
+
+namespace ctb::vector {
+
+/* Storage layouts of a matrix, each one maps a logical (row, col) to an offset
+ * in the underlying vector.
+ */
+namespace layout {
+
+struct row_major {
+    template<len_type_ R, len_type_ C>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    static constexpr len_type_ offset(len_type_ r, len_type_ c) noexcept {
+        return r * C + c;
+    }
+};
+
+struct col_major {
+    template<len_type_ R, len_type_ C>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    static constexpr len_type_ offset(len_type_ r, len_type_ c) noexcept {
+        return c * R + r;
+    }
+};
+
+/* B x B tiles stored one after another (tiles in row-major order),
+ * every tile is row-major itself.
+ */
+template<len_type_ B>
+struct blocked {
+    static_assert(B > 0);
+
+    template<len_type_ R, len_type_ C>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    static constexpr len_type_ offset(len_type_ r, len_type_ c) noexcept {
+        static_assert(R % B == 0 && C % B == 0, "ctb::vector::LayoutError: dimensions must be multiples of the block");
+        return ((r / B) * (C / B) + c / B) * (B * B) + (r % B) * B + c % B;
+    }
+};
+
+} // namespace layout
+
+namespace details {
+
+/* Loops whose trip count does not exceed this limit are fully unrolled.
+ */
+inline constexpr len_type_ unroll_limit_{16};
+
+template<len_type_ N, typename F>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+constexpr void static_for_(F&& f) noexcept {
+    if constexpr (N <= ::ctb::vector::details::unroll_limit_) {
+        [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            (f(I), ...);
+        }(::std::make_index_sequence<N>{});
+    } else {
+        for (len_type_ i{}; i < N; ++i) {
+            f(i);
+        }
+    }
+}
+
+template<typename T>
+[[nodiscard]]
+constexpr T abs_(T x) noexcept {
+    return x < T{} ? -x : x;
+}
+
+} // namespace details
+
+/* A fixed-size matrix stored in a ctb::vector
+ *
+ * Layout only changes the storage order, every function here works with
+ * logical (row, col) indices.
+ */
+template<typename T, len_type_ R, len_type_ C, typename Layout = layout::row_major>
+struct matrix {
+    static_assert(R > 0 && C > 0);
+
+    using value_type = T;
+    using layout_type = Layout;
+    ::ctb::vector::vector<T, R * C> data{};
+
+    constexpr matrix() noexcept = default;
+    constexpr ~matrix() noexcept = default;
+
+    /* Init from a row-major nested array, whatever the layout is
+     */
+    constexpr matrix(T const (&rows)[R][C]) noexcept {
+        for (len_type_ r{}; r < R; ++r) {
+            for (len_type_ c{}; c < C; ++c) {
+                (*this)(r, c) = rows[r][c];
+            }
+        }
+    }
+
+    [[nodiscard]]
+    static constexpr matrix identity() noexcept
+        requires (R == C)
+    {
+        matrix res{};
+        for (len_type_ i{}; i < R; ++i) {
+            res(i, i) = T{1};
+        }
+        return res;
+    }
+
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    constexpr T& operator()(len_type_ r, len_type_ c) noexcept {
+        exception::assert_true(r < R && c < C);
+        return this->data.arr[Layout::template offset<R, C>(r, c)];
+    }
+
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    [[nodiscard]]
+    constexpr T const& operator()(len_type_ r, len_type_ c) const noexcept {
+        exception::assert_true(r < R && c < C);
+        return this->data.arr[Layout::template offset<R, C>(r, c)];
+    }
+
+    template<typename U, typename Layout_r>
+    [[nodiscard]]
+    constexpr bool operator==(matrix<U, R, C, Layout_r> const& other) const noexcept {
+        for (len_type_ r{}; r < R; ++r) {
+            for (len_type_ c{}; c < C; ++c) {
+                if ((*this)(r, c) != other(r, c)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ rows() noexcept {
+        return R;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ cols() noexcept {
+        return C;
+    }
+};
+
+namespace details {
+
+template<typename T>
+constexpr bool is_matrix_ = false;
+
+template<typename T, len_type_ R, len_type_ C, typename Layout>
+constexpr bool is_matrix_<matrix<T, R, C, Layout>> = true;
+
+} // namespace details
+
+template<typename T>
+concept is_matrix = details::is_matrix_<::std::remove_cvref_t<T>>;
+
+/* Matrix product, the result uses the layout of lhs.
+ *
+ * Every row of the result is accumulated in a local array, the column loop
+ * (and the inner-product loop for small sizes) is unrolled at compile time,
+ * so the accumulators stay in registers.
+ */
+template<typename T, len_type_ R, len_type_ K, len_type_ C, typename Layout, typename Layout_r>
+[[nodiscard]]
+constexpr auto matmul(matrix<T, R, K, Layout> const& lhs, matrix<T, K, C, Layout_r> const& rhs) noexcept {
+    matrix<T, R, C, Layout> res{};
+    for (len_type_ i{}; i < R; ++i) {
+        T acc[C]{};
+        details::static_for_<K>([&](len_type_ k) {
+            T const a = lhs(i, k);
+            details::static_for_<C>([&](len_type_ j) {
+                acc[j] += a * rhs(k, j);
+            });
+        });
+        details::static_for_<C>([&](len_type_ j) {
+            res(i, j) = acc[j];
+        });
+    }
+    return res;
+}
+
+template<typename T, len_type_ R, len_type_ C, typename Layout>
+[[nodiscard]]
+constexpr auto transpose(matrix<T, R, C, Layout> const& mat) noexcept {
+    matrix<T, C, R, Layout> res{};
+    for (len_type_ r{}; r < R; ++r) {
+        details::static_for_<C>([&](len_type_ c) {
+            res(c, r) = mat(r, c);
+        });
+    }
+    return res;
+}
+
+/* Apply f to every element, the storage order is kept.
+ */
+template<typename T, len_type_ R, len_type_ C, typename Layout, typename F>
+    requires (::std::is_invocable_v<F const&, T const&>)
+[[nodiscard]]
+constexpr auto apply(matrix<T, R, C, Layout> const& mat, F const& f) noexcept {
+    matrix<::std::remove_cvref_t<::std::invoke_result_t<F const&, T const&>>, R, C, Layout> res{};
+    details::static_for_<R * C>([&](len_type_ i) {
+        res.data.arr[i] = f(mat.data.arr[i]);
+    });
+    return res;
+}
+
+namespace details {
+
+/* Gauss-Jordan elimination with partial pivoting,
+ * returns the determinant and turns inv into the inverse if it is not singular.
+ * A pivot within N * epsilon of the largest entry is rounding left over from a
+ * rank-deficient matrix, so it counts as singular.
+ */
+template<::std::floating_point T, len_type_ N, typename Layout>
+[[nodiscard]]
+constexpr T gauss_jordan_(matrix<T, N, N, Layout> mat, matrix<T, N, N, Layout>& inv) noexcept {
+    T norm{};
+    for (len_type_ i{}; i < N * N; ++i) {
+        norm = ::std::max(norm, details::abs_(mat.data.arr[i]));
+    }
+    T const tolerance = ::std::numeric_limits<T>::epsilon() * static_cast<T>(N) * norm;
+
+    T det{1};
+    for (len_type_ col{}; col < N; ++col) {
+        len_type_ pivot{col};
+        for (len_type_ r{col + 1}; r < N; ++r) {
+            if (details::abs_(mat(r, col)) > details::abs_(mat(pivot, col))) {
+                pivot = r;
+            }
+        }
+        if (details::abs_(mat(pivot, col)) <= tolerance) {
+            return T{};
+        }
+        if (pivot != col) {
+            for (len_type_ c{}; c < N; ++c) {
+                ::std::swap(mat(pivot, c), mat(col, c));
+                ::std::swap(inv(pivot, c), inv(col, c));
+            }
+            det = -det;
+        }
+
+        T const p = mat(col, col);
+        det *= p;
+        for (len_type_ c{}; c < N; ++c) {
+            mat(col, c) /= p;
+            inv(col, c) /= p;
+        }
+        for (len_type_ r{}; r < N; ++r) {
+            if (r == col) {
+                continue;
+            }
+            T const factor = mat(r, col);
+            for (len_type_ c{}; c < N; ++c) {
+                mat(r, c) -= factor * mat(col, c);
+                inv(r, c) -= factor * inv(col, c);
+            }
+        }
+    }
+    return det;
+}
+
+} // namespace details
+
+template<::std::floating_point T, len_type_ N, typename Layout>
+    requires (N <= 4)
+[[nodiscard]]
+constexpr T determinant(matrix<T, N, N, Layout> const& mat) noexcept {
+    auto inv = matrix<T, N, N, Layout>::identity();
+    return details::gauss_jordan_(mat, inv);
+}
+
+/* Inverse of a small square matrix, nullopt if it is singular.
+ */
+template<::std::floating_point T, len_type_ N, typename Layout>
+    requires (N <= 4)
+[[nodiscard]]
+constexpr auto inverse(matrix<T, N, N, Layout> const& mat) noexcept
+    -> exception::optional<matrix<T, N, N, Layout>> {
+    auto inv = matrix<T, N, N, Layout>::identity();
+    if (details::gauss_jordan_(mat, inv) == T{}) {
+        return exception::nullopt;
+    }
+    return inv;
+}
+
+} // namespace ctb::vector
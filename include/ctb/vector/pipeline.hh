@@ -0,0 +1,369 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include "../tuple.hh"
+#include "../vector.hh"
+
+/* Lazy pipelines over ctb::vector
+ *
+ * Usage: vec | map(f) | filter(p) | reduce(op, init)
+ *
+ * Every stage only wraps the previous one, nothing is materialised until a
+ * terminal (reduce, count, for_each, to_vector) is applied. The terminal drives
+ * a single loop over the source and pushes every element through all stages,
+ * so the whole pipeline fuses into one pass.
+ */
+namespace ctb::vector {
+
+namespace details {
+
+/* Vec is a const reference to an lvalue source, or the vector itself when the
+ * pipeline was built from a temporary, so the pipeline never outlives its data.
+ */
+template<typename T, len_type_ N, typename Vec = ::ctb::vector::vector<T, N> const&>
+struct vector_source_ {
+    using reference = T const&;
+    using value_type = T;
+    static constexpr len_type_ max_size{N};
+    static constexpr bool is_exact_size{true};
+
+    Vec vec_;
+
+    /* Push every element to sink, stop as soon as sink returns false.
+     */
+    template<typename Sink>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bool run_(Sink&& sink) const noexcept {
+        for (len_type_ i{}; i < N; ++i) {
+            if (!sink(this->vec_.arr[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template<len_type_ N, typename... Ts>
+struct zip_source_ {
+    using reference = ::ctb::tuple::tuple<Ts const&...>;
+    using value_type = reference;
+    static constexpr len_type_ max_size{N};
+    static constexpr bool is_exact_size{true};
+
+    ::ctb::tuple::tuple<::ctb::vector::vector<Ts, N> const&...> vecs_;
+
+    template<typename Sink>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bool run_(Sink&& sink) const noexcept {
+        return [&]<::std::size_t... I>(::std::index_sequence<I...>) {
+            for (len_type_ i{}; i < N; ++i) {
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+                if (!sink(reference{::ctb::tuple::get<I>(this->vecs_).arr[i]...})) {
+                    return false;
+                }
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+            }
+            return true;
+        }(::std::make_index_sequence<sizeof...(Ts)>{});
+    }
+};
+
+template<typename Source, typename Stage>
+struct view_ {
+    using reference = typename Stage::template reference<typename Source::reference>;
+    using value_type = ::std::remove_cvref_t<reference>;
+    static constexpr len_type_ max_size{Source::max_size};
+    static constexpr bool is_exact_size{Source::is_exact_size && Stage::is_size_preserving};
+
+    Source source_;
+    Stage stage_;
+
+    template<typename Sink>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bool run_(Sink&& sink) const noexcept {
+        return this->source_.run_([&](auto&& val) {
+            return this->stage_.push_(::std::forward<decltype(val)>(val), sink);
+        });
+    }
+};
+
+template<typename F>
+struct map_ {
+    template<typename Ref>
+    using reference = ::std::invoke_result_t<F const&, Ref>;
+    static constexpr bool is_size_preserving{true};
+
+    F f_;
+
+    template<typename T, typename Sink>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bool push_(T&& val, Sink& sink) const noexcept {
+        return sink(this->f_(::std::forward<T>(val)));
+    }
+};
+
+template<typename Pred>
+struct filter_ {
+    template<typename Ref>
+    using reference = Ref;
+    static constexpr bool is_size_preserving{false};
+
+    Pred pred_;
+
+    template<typename T, typename Sink>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+    [[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+    [[msvc::forceinline]]
+#endif
+    constexpr bool push_(T&& val, Sink& sink) const noexcept {
+        if (this->pred_(::std::as_const(val))) {
+            return sink(::std::forward<T>(val));
+        }
+        return true;
+    }
+};
+
+template<typename Op, typename T>
+struct reduce_ {
+    Op op_;
+    T init_;
+
+    template<typename Source>
+    [[nodiscard]]
+    constexpr auto finish_(Source const& source) const noexcept {
+        T acc{this->init_};
+        source.run_([&](auto&& val) {
+            acc = this->op_(::std::move(acc), ::std::forward<decltype(val)>(val));
+            return true;
+        });
+        return acc;
+    }
+};
+
+struct count_ {
+    template<typename Source>
+    [[nodiscard]]
+    constexpr len_type_ finish_(Source const& source) const noexcept {
+        if constexpr (Source::is_exact_size) {
+            return Source::max_size;
+        } else {
+            len_type_ n{};
+            source.run_([&](auto&&) {
+                ++n;
+                return true;
+            });
+            return n;
+        }
+    }
+};
+
+template<typename F>
+struct for_each_ {
+    F f_;
+
+    template<typename Source>
+    constexpr void finish_(Source const& source) const noexcept {
+        source.run_([&](auto&& val) {
+            this->f_(::std::forward<decltype(val)>(val));
+            return true;
+        });
+    }
+};
+
+struct to_vector_ {
+    template<typename Source>
+    [[nodiscard]]
+    constexpr auto finish_(Source const& source) const noexcept {
+        static_assert(Source::is_exact_size,
+                      "ctb::vector::SizeError: size of a filtered pipeline is unknown, use `collect` instead");
+
+        ::ctb::vector::vector<typename Source::value_type, Source::max_size> res{};
+        len_type_ i{};
+        source.run_([&](auto&& val) {
+            res.arr[i++] = ::std::forward<decltype(val)>(val);
+            return true;
+        });
+        return res;
+    }
+};
+
+template<typename>
+constexpr bool is_stage_ = false;
+
+template<typename F>
+constexpr bool is_stage_<map_<F>> = true;
+
+template<typename Pred>
+constexpr bool is_stage_<filter_<Pred>> = true;
+
+template<typename>
+constexpr bool is_terminal_ = false;
+
+template<typename Op, typename T>
+constexpr bool is_terminal_<reduce_<Op, T>> = true;
+
+template<>
+constexpr bool is_terminal_<count_> = true;
+
+template<typename F>
+constexpr bool is_terminal_<for_each_<F>> = true;
+
+template<>
+constexpr bool is_terminal_<to_vector_> = true;
+
+template<typename>
+constexpr bool is_source_ = false;
+
+template<typename T, len_type_ N, typename Vec>
+constexpr bool is_source_<vector_source_<T, N, Vec>> = true;
+
+template<len_type_ N, typename... Ts>
+constexpr bool is_source_<zip_source_<N, Ts...>> = true;
+
+template<typename Source, typename Stage>
+constexpr bool is_source_<view_<Source, Stage>> = true;
+
+template<typename T>
+concept is_pipeline_source = is_source_<::std::remove_cvref_t<T>> || ::ctb::vector::is_vector<T>;
+
+template<is_pipeline_source T>
+#if __has_cpp_attribute(__gnu__::__always_inline__)
+[[__gnu__::__always_inline__]]
+#elif __has_cpp_attribute(msvc::forceinline)
+[[msvc::forceinline]]
+#endif
+[[nodiscard]]
+constexpr auto as_source_(T&& src) noexcept {
+    using type = ::std::remove_cvref_t<T>;
+    if constexpr (!::ctb::vector::is_vector<T>) {
+        return type{::std::forward<T>(src)};
+    } else if constexpr (::std::is_lvalue_reference_v<T>) {
+        return vector_source_<typename type::value_type, type::size()>{src};
+    } else {
+        return vector_source_<typename type::value_type, type::size(), type>{::std::move(src)};
+    }
+}
+
+/* operator| lives here so that ADL finds it through the stage or terminal,
+ * which always comes from this namespace.
+ */
+template<is_pipeline_source Src, typename Stage>
+    requires (is_stage_<Stage>)
+[[nodiscard]]
+constexpr auto operator|(Src&& src, Stage const& stage) noexcept {
+    using source_type = decltype(::ctb::vector::details::as_source_(::std::forward<Src>(src)));
+    return view_<source_type, Stage>{::ctb::vector::details::as_source_(::std::forward<Src>(src)), stage};
+}
+
+template<is_pipeline_source Src, typename Terminal>
+    requires (is_terminal_<Terminal>)
+constexpr decltype(auto) operator|(Src&& src, Terminal const& terminal) noexcept {
+    return terminal.finish_(::ctb::vector::details::as_source_(::std::forward<Src>(src)));
+}
+
+} // namespace details
+
+template<typename F>
+[[nodiscard]]
+constexpr auto map(F f) noexcept {
+    return details::map_<F>{::std::move(f)};
+}
+
+template<typename Pred>
+[[nodiscard]]
+constexpr auto filter(Pred pred) noexcept {
+    return details::filter_<Pred>{::std::move(pred)};
+}
+
+/* Iterate several vectors with the same length in lockstep,
+ * every element is a ctb::tuple::tuple of const references.
+ */
+template<typename T, typename... Ts, len_type_ N>
+[[nodiscard]]
+constexpr auto zip(vector<T, N> const& vec, vector<Ts, N> const&... vecs) noexcept {
+#if defined(__clang__)
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+    return details::zip_source_<N, T, Ts...>{{vec, vecs...}};
+#if defined(__clang__)
+    #pragma clang diagnostic pop
+#endif
+}
+
+template<typename Op, typename T>
+[[nodiscard]]
+constexpr auto reduce(Op op, T init) noexcept {
+    return details::reduce_<Op, T>{::std::move(op), ::std::move(init)};
+}
+
+[[nodiscard]]
+constexpr auto count() noexcept {
+    return details::count_{};
+}
+
+template<typename F>
+[[nodiscard]]
+constexpr auto for_each(F f) noexcept {
+    return details::for_each_<F>{::std::move(f)};
+}
+
+/* Materialise a pipeline whose length is known at compile time
+ * (i.e. no filter in it).
+ */
+[[nodiscard]]
+constexpr auto to_vector() noexcept {
+    return details::to_vector_{};
+}
+
+/* Materialise any pipeline at compile time, the length of the result is exactly
+ * the number of elements the pipeline yields.
+ *
+ * Usage: collect<vec>([](auto const& src) { return src | filter(p); })
+ */
+template<auto vec, typename Build>
+    requires (::ctb::vector::is_vector<decltype(vec)> && ::std::is_default_constructible_v<Build>)
+[[nodiscard]]
+consteval auto collect(Build) noexcept {
+    using view_type = decltype(Build{}(vec));
+    constexpr auto n = Build{}(vec) | ::ctb::vector::count();
+    static_assert(n > 0, "ctb::vector::SizeError: the pipeline yields nothing");
+
+    typename view_type::value_type tmp_[n]{};
+    len_type_ i{};
+    Build{}(vec) | ::ctb::vector::for_each([&](auto&& val) {
+        tmp_[i++] = ::std::forward<decltype(val)>(val);
+    });
+    return vector{tmp_};
+}
+
+} // namespace ctb::vector
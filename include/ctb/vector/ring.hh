@@ -0,0 +1,261 @@
+#pragma once
+
+#if __cpp_concepts < 201907L
+    #error "`ctb` requires at least C++20"
+#endif // __cpp_concepts < 201907L
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "../utils.hh"
+#include "../vector.hh"
+
+namespace ctb::vector {
+
+namespace details {
+
+template<len_type_ Cap>
+concept is_ring_capacity_ = Cap > 0 && (Cap & (Cap - 1)) == 0;
+
+/* Copy n elements from src to a ring starting at logical position pos,
+ * as (at most) two contiguous runs.
+ */
+template<len_type_ Cap, typename T, typename U>
+constexpr void ring_copy_in_(T* ring, len_type_ pos, U* src, len_type_ n) noexcept {
+    auto const first = pos & (Cap - 1);
+    auto const run = ::std::min(n, Cap - first);
+    ::std::move(src, src + run, ring + first);
+    ::std::move(src + run, src + n, ring);
+}
+
+template<len_type_ Cap, typename T, typename U>
+constexpr void ring_copy_out_(T* ring, len_type_ pos, U* dst, len_type_ n) noexcept {
+    auto const first = pos & (Cap - 1);
+    auto const run = ::std::min(n, Cap - first);
+    ::std::move(ring + first, ring + first + run, dst);
+    ::std::move(ring, ring + (n - run), dst + run);
+}
+
+} // namespace details
+
+/* Lock-free single-producer single-consumer ring buffer
+ *
+ * Elements are stored inline, Cap must be a power of two so that wrapping
+ * is a mask. Indices are never wrapped themselves, tail - head is the size.
+ *
+ * Producer and consumer each own one cache line: the index it publishes and
+ * its private copy of the peer's index, which is only reloaded (acquire) when
+ * the ring looks full or empty.
+ */
+template<typename T, len_type_ Cap>
+    requires (details::is_ring_capacity_<Cap> && ::std::is_default_constructible_v<T>)
+class spsc_ring {
+    static constexpr len_type_ mask_{Cap - 1};
+
+    // producer-owned
+    alignas(::ctb::utils::cache_line_size) ::std::atomic<len_type_> tail_{};
+    len_type_ head_cache_{};
+
+    // consumer-owned
+    alignas(::ctb::utils::cache_line_size) ::std::atomic<len_type_> head_{};
+    len_type_ tail_cache_{};
+
+    alignas(::ctb::utils::cache_line_size) ::ctb::vector::vector<T, Cap> buf_{};
+
+public:
+    using value_type = T;
+
+    constexpr spsc_ring() noexcept = default;
+    constexpr ~spsc_ring() noexcept = default;
+    spsc_ring(spsc_ring const&) = delete;
+    spsc_ring& operator=(spsc_ring const&) = delete;
+
+    /* Producer side, false if the ring is full
+     */
+    template<typename U>
+        requires (::std::is_assignable_v<T&, U &&>)
+    [[nodiscard]]
+    bool push(U&& val) noexcept {
+        auto const tail = this->tail_.load(::std::memory_order_relaxed);
+        if (tail - this->head_cache_ == Cap) {
+            this->head_cache_ = this->head_.load(::std::memory_order_acquire);
+            if (tail - this->head_cache_ == Cap) {
+                return false;
+            }
+        }
+        this->buf_.arr[tail & mask_] = ::std::forward<U>(val);
+        this->tail_.store(tail + 1, ::std::memory_order_release);
+        return true;
+    }
+
+    /* Producer side, push as many of src[0, n) as fit and publish them at once
+     *
+     * Returns the number of pushed elements.
+     */
+    template<typename U>
+    [[nodiscard]]
+    len_type_ push_n(U* src, len_type_ n) noexcept {
+        auto const tail = this->tail_.load(::std::memory_order_relaxed);
+        if (Cap - (tail - this->head_cache_) < n) {
+            this->head_cache_ = this->head_.load(::std::memory_order_acquire);
+        }
+        n = ::std::min(n, Cap - (tail - this->head_cache_));
+        details::ring_copy_in_<Cap>(this->buf_.arr, tail, src, n);
+        this->tail_.store(tail + n, ::std::memory_order_release);
+        return n;
+    }
+
+    /* Consumer side, false if the ring is empty
+     */
+    [[nodiscard]]
+    bool pop(T& out) noexcept {
+        auto const head = this->head_.load(::std::memory_order_relaxed);
+        if (head == this->tail_cache_) {
+            this->tail_cache_ = this->tail_.load(::std::memory_order_acquire);
+            if (head == this->tail_cache_) {
+                return false;
+            }
+        }
+        out = ::std::move(this->buf_.arr[head & mask_]);
+        this->head_.store(head + 1, ::std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer side, pop up to n elements into dst[0, n)
+     *
+     * Returns the number of popped elements.
+     */
+    [[nodiscard]]
+    len_type_ pop_n(T* dst, len_type_ n) noexcept {
+        auto const head = this->head_.load(::std::memory_order_relaxed);
+        if (this->tail_cache_ - head < n) {
+            this->tail_cache_ = this->tail_.load(::std::memory_order_acquire);
+        }
+        n = ::std::min(n, this->tail_cache_ - head);
+        details::ring_copy_out_<Cap>(this->buf_.arr, head, dst, n);
+        this->head_.store(head + n, ::std::memory_order_release);
+        return n;
+    }
+
+    /* Only a snapshot if the other side is running
+     */
+    [[nodiscard]]
+    len_type_ size() const noexcept {
+        return this->tail_.load(::std::memory_order_acquire) - this->head_.load(::std::memory_order_acquire);
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ capacity() noexcept {
+        return Cap;
+    }
+};
+
+/* Lock-free multi-producer single-consumer ring buffer
+ *
+ * Producers claim a slot by CAS on tail, then publish it through the slot's
+ * sequence number, so the consumer never waits on a producer that has not
+ * claimed its slot yet (Vyukov's bounded queue, specialised for one consumer).
+ */
+template<typename T, len_type_ Cap>
+    requires (details::is_ring_capacity_<Cap> && ::std::is_default_constructible_v<T>)
+class mpsc_ring {
+    static constexpr len_type_ mask_{Cap - 1};
+
+    // shared by producers
+    alignas(::ctb::utils::cache_line_size) ::std::atomic<len_type_> tail_{};
+
+    // consumer-owned
+    alignas(::ctb::utils::cache_line_size) len_type_ head_{};
+
+    alignas(::ctb::utils::cache_line_size) ::std::atomic<len_type_> seq_[Cap];
+    ::ctb::vector::vector<T, Cap> buf_{};
+
+public:
+    using value_type = T;
+
+    mpsc_ring() noexcept {
+        for (len_type_ i{}; i < Cap; ++i) {
+            this->seq_[i].store(i, ::std::memory_order_relaxed);
+        }
+    }
+
+    ~mpsc_ring() noexcept = default;
+    mpsc_ring(mpsc_ring const&) = delete;
+    mpsc_ring& operator=(mpsc_ring const&) = delete;
+
+    /* Producer side (any thread), false if the ring is full
+     */
+    template<typename U>
+        requires (::std::is_assignable_v<T&, U &&>)
+    [[nodiscard]]
+    bool push(U&& val) noexcept {
+        auto pos = this->tail_.load(::std::memory_order_relaxed);
+        for (;;) {
+            auto const seq = this->seq_[pos & mask_].load(::std::memory_order_acquire);
+            auto const diff = static_cast<::std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (this->tail_.compare_exchange_weak(pos, pos + 1, ::std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->tail_.load(::std::memory_order_relaxed);
+            }
+        }
+        this->buf_.arr[pos & mask_] = ::std::forward<U>(val);
+        this->seq_[pos & mask_].store(pos + 1, ::std::memory_order_release);
+        return true;
+    }
+
+    /* Producer side, returns the number of pushed elements
+     *
+     * Slots are claimed one by one, elements of one call may interleave with
+     * elements of other producers.
+     */
+    template<typename U>
+    [[nodiscard]]
+    len_type_ push_n(U* src, len_type_ n) noexcept {
+        for (len_type_ i{}; i < n; ++i) {
+            if (!this->push(::std::move(src[i]))) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    /* Consumer side, false if the ring is empty
+     */
+    [[nodiscard]]
+    bool pop(T& out) noexcept {
+        auto const pos = this->head_;
+        if (this->seq_[pos & mask_].load(::std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        out = ::std::move(this->buf_.arr[pos & mask_]);
+        this->seq_[pos & mask_].store(pos + Cap, ::std::memory_order_release);
+        this->head_ = pos + 1;
+        return true;
+    }
+
+    /* Consumer side, pop up to n published elements into dst[0, n)
+     */
+    [[nodiscard]]
+    len_type_ pop_n(T* dst, len_type_ n) noexcept {
+        for (len_type_ i{}; i < n; ++i) {
+            if (!this->pop(dst[i])) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    [[nodiscard]]
+    static constexpr len_type_ capacity() noexcept {
+        return Cap;
+    }
+};
+
+} // namespace ctb::vector
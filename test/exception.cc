@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <ctb/exception.hh>
 
 using namespace ctb::exception;
@@ -34,6 +38,88 @@ consteval void test_expected() noexcept {
     // static_assert(value_or(y, 2.5) == 2); // error, implicit conversion is not allowed
 }
 
+enum class color : unsigned char {
+    red,
+    green,
+};
+
+template<>
+struct ctb::exception::niche_traits<color> {
+    [[nodiscard]]
+    static constexpr color make() noexcept {
+        return static_cast<color>(0xff);
+    }
+
+    [[nodiscard]]
+    static constexpr bool is_niche(color c) noexcept {
+        return c == make();
+    }
+};
+
+struct not_found {};
+
+inline constexpr int answer{42};
+
+consteval void test_niche() noexcept {
+    static_assert(sizeof(optional<non_null<int*>>) == sizeof(int*));
+    static_assert(sizeof(optional<color>) == sizeof(color));
+    static_assert(sizeof(expected<non_null<int const*>, not_found>) == sizeof(int const*));
+    static_assert(sizeof(optional<int>) == 2 * sizeof(int));
+    static_assert(::std::is_trivially_copyable_v<optional<non_null<int*>>>);
+    static_assert(has_niche<non_null<int*>> && has_niche<color> && !has_niche<int>);
+    static_assert(!::std::is_constructible_v<non_null<int*>, ::std::nullptr_t>);
+
+    // raw pointers have no niche, a null pointer is an engaged value
+    static_assert(!has_niche<int*>);
+    static_assert(sizeof(optional<int*>) == 2 * sizeof(int*));
+    static_assert(optional<int const*>{nullptr}.has_value());
+    static_assert(optional<int const*>{nullptr}.value() == nullptr);
+
+    constexpr auto x = optional<non_null<int const*>>{non_null{&answer}};
+    constexpr auto y = optional<non_null<int const*>>{nullopt};
+    static_assert(x.has_value() && *x.value() == 42);
+    static_assert(!y.has_value() && y.value_or(non_null{&answer}) == &answer);
+    static_assert(optional<color>{color::green}.value() == color::green);
+    static_assert(!optional<color>{nullopt}.has_value());
+    static_assert(!expected<non_null<int const*>, not_found>{unexpected<not_found>{}}.has_value());
+}
+
+inline void test_niche_in_runtime() noexcept {
+    int a{1}, b{2};
+    auto x = optional<non_null<int*>>{non_null{&a}};
+    assert_true(x.has_value() && x.value() == &a);
+    x = nullopt;
+    assert_true(!x.has_value());
+    x = non_null{&b};
+    auto y = optional<non_null<int*>>{nullopt};
+    x.swap(y);
+    assert_true(!x.has_value() && *y.value() == 2);
+
+    int* null{};
+    auto z = optional<int*>{null};
+    assert_true(z.has_value() && z.value() == nullptr);
+}
+
+// both storages share one set of accessors
+static_assert(::std::is_same_v<decltype(optional<int>{1}.has_value()), bool>);
+static_assert(::std::is_same_v<decltype(optional<color>{color::red}.has_value()), bool>);
+static_assert(::std::is_same_v<decltype(optional<int>{1}.value()), int&&>);
+static_assert(::std::is_same_v<decltype(optional<color>{color::red}.value()), color&&>);
+
+inline void test_switch_in_runtime() noexcept {
+    // the alive member of the union changes, non-trivial members are destroyed and constructed
+    auto x = expected<::std::string, ::std::string>{::std::string(32, 'a')};
+    x = ::ctb::exception::unexpected{::std::string(32, 'e')};
+    assert_true(!x.has_value() && x.error() == ::std::string(32, 'e'));
+    x = ::std::string(32, 'b');
+    assert_true(x.has_value() && x.value() == ::std::string(32, 'b'));
+    auto y = expected<::std::string, ::std::string>{::ctb::exception::unexpected{::std::string{"f"}}};
+    x.swap(y);
+    assert_true(!x.has_value() && x.error() == "f" && y.value() == ::std::string(32, 'b'));
+    x = y;
+    assert_true(x.has_value() && x.value() == y.value());
+}
+
 inline void test_optional_in_runtime() noexcept {
     auto x = optional<int>{1};
     x = 2;
@@ -55,10 +141,16 @@ inline void test_expected_in_runtime() noexcept {
     x.swap(z);
     assert_true(x.error() == 1);
     assert_true(z.value() == 2);
+
+    z.value() = 3;
+    assert_true(z.value() == 3);
+    static_assert(::std::is_same_v<decltype(::std::move(z).value()), int&&>);
 }
 
 int main() noexcept {
     test_optional_in_runtime();
     test_expected_in_runtime();
+    test_niche_in_runtime();
+    test_switch_in_runtime();
     return 0;
 }
@@ -0,0 +1,34 @@
+// every public header in one translation unit, so clashing internal names do not compile
+#include <ctb/exception.hh>
+#include <ctb/namedtuple.hh>
+#include <ctb/namedtuple/binary.hh>
+#include <ctb/namedtuple/hash.hh>
+#include <ctb/namedtuple/json.hh>
+#include <ctb/namedtuple/lookup.hh>
+#include <ctb/namedtuple/mapped_table.hh>
+#include <ctb/namedtuple/packed.hh>
+#include <ctb/namedtuple/padded.hh>
+#include <ctb/namedtuple/query.hh>
+#include <ctb/namedtuple/soa_vector.hh>
+#include <ctb/namedtuple/wire_view.hh>
+#include <ctb/string.hh>
+#include <ctb/tuple.hh>
+#include <ctb/tuple/algorithm.hh>
+#include <ctb/tuple/binary.hh>
+#include <ctb/tuple/hash.hh>
+#include <ctb/tuple/packed.hh>
+#include <ctb/tuple/padded.hh>
+#include <ctb/utils.hh>
+#include <ctb/variant.hh>
+#include <ctb/vector.hh>
+#include <ctb/vector/arena.hh>
+#include <ctb/vector/bitset.hh>
+#include <ctb/vector/flat_map.hh>
+#include <ctb/vector/hash_map.hh>
+#include <ctb/vector/matrix.hh>
+#include <ctb/vector/pipeline.hh>
+#include <ctb/vector/ring.hh>
+
+int main() noexcept {
+    return 0;
+}
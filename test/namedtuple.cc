@@ -1,4 +1,11 @@
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <ctb/exception.hh>
 #include <ctb/namedtuple.hh>
 
 using namespace ctb::namedtuple;
@@ -9,6 +16,8 @@ consteval void test_names() noexcept {
     static_assert(details::get_name<1, names<"a", "blabla">>() == "blabla");
     static_assert(details::get_name<0, names<u8"滑稽", "bla">>() == u8"滑稽");
     static_assert(details::get_size<names<"a", "blabla">>() == 2);
+    static_assert(details::get_index<"blabla", names<"a", "blabla">>() == 1);
+    static_assert(details::get_index<"c", names<"a", "blabla">>() == 2);
 }
 
 consteval void test_namedtuple() noexcept {
@@ -18,6 +27,113 @@ consteval void test_namedtuple() noexcept {
     [[maybe_unused]] auto [a, b]{nt};
 }
 
+consteval void test_get_reference() noexcept {
+    auto nt = make_namedtuple<"a", "b">(1, 2.);
+    auto const& cnt = nt;
+    static_assert(::std::same_as<decltype(get<"a">(nt)), int&>);
+    static_assert(::std::same_as<decltype(get<"a">(cnt)), int const&>);
+    static_assert(::std::same_as<decltype(get<"b">(::std::move(nt))), double&&>);
+    static_assert(::std::same_as<decltype(get<1>(nt)), double&>);
+    static_assert(::std::same_as<::std::tuple_element_t<1, decltype(nt)>, double>);
+}
+
+constexpr bool test_get_assign() noexcept {
+    auto nt = make_namedtuple<"a", "b">(1, 2.);
+    get<"a">(nt) = 5;
+    get<1>(nt) += 1.;
+    return get<0>(nt) == 5 && get<"b">(nt) == 3.;
+}
+
+static_assert(test_get_assign());
+
+inline void test_get_no_copy() noexcept {
+    auto nt = make_namedtuple<"name", "id">(::std::string(64, 'x'), 1);
+    auto const* data = get<"name">(nt).data();
+    ctb::exception::assert_true(get<"name">(nt).data() == data);
+    auto moved = get<"name">(::std::move(nt));
+    ctb::exception::assert_true(moved.data() == data);
+}
+
+struct plain {
+    int a;
+    double b;
+};
+
+consteval void test_trivial() noexcept {
+    using nt_type = namedtuple<names<"a", "b">, int, double>;
+    static_assert(::std::is_trivially_copyable_v<ctb::tuple::tuple<int, double>>);
+    static_assert(::std::is_trivially_copyable_v<nt_type>);
+    static_assert(::std::is_trivially_destructible_v<nt_type>);
+    static_assert(::std::is_trivially_default_constructible_v<nt_type>);
+    static_assert(::std::is_nothrow_move_constructible_v<namedtuple<names<"s">, ::std::string>>);
+    static_assert(!::std::is_trivially_copyable_v<namedtuple<names<"s">, ::std::string>>);
+    // one base per field, so only a single field is standard-layout
+    static_assert(::std::is_standard_layout_v<namedtuple<names<"a">, int>>);
+    static_assert(!::std::is_standard_layout_v<nt_type>);
+    // same object representation as the equivalent struct
+    static_assert(sizeof(nt_type) == sizeof(plain) && alignof(nt_type) == alignof(plain));
+    constexpr auto p = ::std::bit_cast<plain>(nt_type{1, 2.});
+    static_assert(p.a == 1 && p.b == 2.);
+    static_assert(get<"b">(::std::bit_cast<nt_type>(plain{3, 4.})) == 4.);
+}
+
+consteval void test_construct() noexcept {
+    using nt_type = namedtuple<names<"a", "b">, long, double>;
+    int const a{1};
+    constexpr nt_type nt{a, 2};
+    static_assert(get<"a">(nt) == 1 && get<"b">(nt) == 2.);
+    static_assert(!::std::constructible_from<nt_type, int>);
+    static_assert(!::std::constructible_from<nt_type, int, char const*>);
+    // arguments convert implicitly, except floating-point into an integer field
+    static_assert(::std::constructible_from<namedtuple<names<"x", "y">, double, unsigned>, int, int>);
+    static_assert(!::std::constructible_from<nt_type, double, double>);
+    static_assert(!::std::constructible_from<namedtuple<names<"n">, unsigned>, float>);
+
+    using nested = namedtuple<names<"inner", "c">, nt_type, int>;
+    constexpr nested n{nt, 3};
+    static_assert(get<"b">(get<"inner">(n)) == 2. && get<"c">(n) == 3);
+    static_assert(get<"c">(nested{}) == 0);
+}
+
+consteval void test_compare() noexcept {
+    using nt_type = namedtuple<names<"a", "b">, int, double>;
+    static_assert(nt_type{1, 2.} == nt_type{1, 2.} && nt_type{1, 2.} != nt_type{1, 3.});
+    static_assert(nt_type{1, 2.} < nt_type{2, 0.});
+    static_assert(make_namedtuple<"a", "b">(1, 2L) == make_namedtuple<"a", "b">(1L, 2));
+    // different names do not compare
+    static_assert(!::std::equality_comparable_with<nt_type, namedtuple<names<"b", "a">, int, double>>);
+}
+
+inline void runtime_test_compare() noexcept {
+    namedtuple<names<"name", "id">, ::std::string, int> a{"x", 1}, b{"x", 2};
+    ctb::exception::assert_true(a != b && a < b);
+    get<"id">(b) = 1;
+    ctb::exception::assert_true(a == b);
+}
+
+inline void runtime_test_memcpy() noexcept {
+    auto const nt = make_namedtuple<"a", "b">(1, 2.);
+    decltype(make_namedtuple<"a", "b">(1, 2.)) copy{};
+    ::std::memcpy(&copy, &nt, sizeof(nt));
+    ctb::exception::assert_true(get<"a">(copy) == 1 && get<"b">(copy) == 2.);
+}
+
+inline void runtime_test_construct_no_copy() noexcept {
+    auto str = ::std::string(64, 'x');
+    auto const* data = str.data();
+    namedtuple<names<"name">, ::std::string> nt{::std::move(str)};
+    ctb::exception::assert_true(get<"name">(nt).data() == data);
+    auto moved = ::std::move(nt);
+    ctb::exception::assert_true(get<"name">(moved).data() == data);
+    // an lvalue is copied
+    namedtuple<names<"name">, ::std::string> copy{get<"name">(moved)};
+    ctb::exception::assert_true(get<"name">(copy).data() != data && get<"name">(copy) == get<"name">(moved));
+}
+
 int main() noexcept {
+    test_get_no_copy();
+    runtime_test_memcpy();
+    runtime_test_construct_no_copy();
+    runtime_test_compare();
     return 0;
 }
@@ -0,0 +1,53 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/binary.hh>
+
+using namespace ctb::namedtuple;
+
+using quote = namedtuple<names<"bid", "ask", "size">, double, double, ::std::uint32_t>;
+
+consteval void test_schema() noexcept {
+    static_assert(ctb::tuple::wire_size<quote> == 8 + 20);
+    static_assert(ctb::tuple::schema_hash<quote> !=
+                  ctb::tuple::schema_hash<ctb::tuple::tuple<double, double, ::std::uint32_t>>);
+    static_assert(ctb::tuple::schema_hash<quote> !=
+                  ctb::tuple::schema_hash<namedtuple<names<"bid", "ask", "qty">, double, double, ::std::uint32_t>>);
+    static_assert(ctb::tuple::schema_hash<namedtuple<names<"ab", "c">, int, int>> !=
+                  ctb::tuple::schema_hash<namedtuple<names<"a", "bc">, int, int>>);
+    // non-ASCII names hash their code units as unsigned, whatever the signedness of char
+    static_assert(ctb::tuple::schema_hash<namedtuple<names<"prix_é", "qté">, double, ::std::uint32_t>> ==
+                  0xd9a531358a77d241);
+}
+
+inline void runtime_test_round_trip() noexcept {
+    auto const q = quote{99.5, 100.25, 300};
+    ::std::array<::std::byte, ctb::tuple::wire_size<quote>> buf{};
+    ctb::exception::assert_true(encode(q, buf).value() == buf.size());
+
+    auto const res = decode<quote>(buf);
+    ctb::exception::assert_true(res.has_value());
+    ctb::exception::assert_true(get<"bid">(res.value()) == 99.5);
+    ctb::exception::assert_true(get<"ask">(res.value()) == 100.25);
+    ctb::exception::assert_true(get<"size">(res.value()) == 300);
+
+    using renamed = namedtuple<names<"bid", "ask", "qty">, double, double, ::std::uint32_t>;
+    ctb::exception::assert_true(decode<renamed>(buf).error() == ctb::tuple::binary_errc::schema_mismatch);
+}
+
+inline void runtime_test_nested() noexcept {
+    using book = namedtuple<names<"top", "seq">, quote, ::std::uint64_t>;
+    static_assert(ctb::tuple::wire_size<book> == 8 + 20 + 8);
+    auto const b = book{quote{1., 2., 3u}, 4u};
+    ::std::array<::std::byte, ctb::tuple::wire_size<book>> buf{};
+    ctb::exception::assert_true(encode(b, buf).has_value());
+    auto const res = decode<book>(buf);
+    ctb::exception::assert_true(get<"ask">(get<"top">(res.value())) == 2. && get<"seq">(res.value()) == 4u);
+}
+
+int main() noexcept {
+    runtime_test_round_trip();
+    runtime_test_nested();
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <string_view>
+#include <unordered_map>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/hash.hh>
+
+using namespace ctb::namedtuple;
+
+using order = namedtuple<names<"sym", "venue", "qty">, ::std::string_view, ::std::string_view, int>;
+
+inline void runtime_test_hash() noexcept {
+    ::std::hash<order> const hash{};
+    ctb::exception::assert_true(hash(order{"AAPL", "XNAS", 1}) == hash(order{"AAPL", "XNAS", 1}));
+    ctb::exception::assert_true(hash(order{"AAPL", "XNAS", 1}) != hash(order{"AAPL", "XNAS", 2}));
+    ctb::exception::assert_true(hash(order{"AAPL", "XNAS", 1}) == ::std::hash<ctb::tuple::tuple<::std::string_view,
+                                ::std::string_view, int>>{}(order{"AAPL", "XNAS", 1}.tuple));
+}
+
+inline void runtime_test_hash_fields() noexcept {
+    order const a{"AAPL", "XNAS", 1}, b{"AAPL", "XNAS", 2}, c{"AAPL", "ARCX", 1};
+    ctb::exception::assert_true(hash_fields<"sym", "venue">(a) == hash_fields<"sym", "venue">(b));
+    ctb::exception::assert_true(hash_fields<"sym", "venue">(a) != hash_fields<"sym", "venue">(c));
+    ctb::exception::assert_true(hash_fields<"sym">(a) == hash_fields<"sym">(c));
+    // the order of the names counts
+    ctb::exception::assert_true(hash_fields<"sym", "venue">(a) != hash_fields<"venue", "sym">(a));
+}
+
+inline void runtime_test_unordered_map() noexcept {
+    using key = namedtuple<names<"id", "side">, int, char>;
+    ::std::unordered_map<key, int> map;
+    map[key{1, 'b'}] = 10;
+    map[key{1, 's'}] = 20;
+    map[key{1, 'b'}] += 1;
+    ctb::exception::assert_true(map.size() == 2 && map.at(key{1, 'b'}) == 11);
+}
+
+int main() noexcept {
+    runtime_test_hash();
+    runtime_test_hash_fields();
+    runtime_test_unordered_map();
+    return 0;
+}
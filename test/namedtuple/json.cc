@@ -0,0 +1,161 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/json.hh>
+#include "wide_names.hh"
+
+using namespace ctb::namedtuple;
+
+using point = namedtuple<names<"x", "y">, ::std::int32_t, ::std::int32_t>;
+using event = namedtuple<names<"id", "ok", "ratio", "name">, ::std::uint64_t, bool, double, ::std::string>;
+
+consteval void test_key_fragments() noexcept {
+    static_assert(details::json_key_<0, event::names> == "{\"id\":");
+    static_assert(details::json_key_<3, event::names> == ",\"name\":");
+    static_assert(details::json_key_<0, names<u8"滑稽">> == "{\"\xe6\xbb\x91\xe7\xa8\xbd\":");
+}
+
+inline void runtime_test_to_json() noexcept {
+    auto const ev = event{42, true, 0.5, "a \"b\"\n"};
+    char buf[128]{};
+    auto const len = to_json(ev, buf);
+    ctb::exception::assert_true(len.has_value());
+    ctb::exception::assert_true(::std::string_view{buf, len.value()} ==
+                                R"({"id":42,"ok":true,"ratio":0.5,"name":"a \"b\"\u000a"})");
+
+    // too small, for every possible cut
+    for (::std::size_t i{}; i < len.value(); ++i) {
+        ctb::exception::assert_true(!to_json(ev, ::std::span<char>{buf, i}).has_value());
+    }
+}
+
+inline void runtime_test_from_json() noexcept {
+    auto ev = event{0, false, 0., ""};
+    constexpr ::std::string_view text{
+        R"( { "name" : "caf\u00e9 \ud83d\ude00\t\"" , "unknown": [1, {"a": "}"}, true], "at": {"y": 7},)"
+        R"( "ratio": -2.5e1, "ok": true, "id": 18446744073709551615 } tail)"};
+    auto const res = from_json(text, ev);
+    ctb::exception::assert_true(res.has_value());
+    ctb::exception::assert_true(text.substr(res.value()) == " tail");
+    ctb::exception::assert_true(get<"id">(ev) == 18446744073709551615u);
+    ctb::exception::assert_true(get<"ok">(ev));
+    ctb::exception::assert_true(get<"ratio">(ev) == -25.);
+    ctb::exception::assert_true(get<"name">(ev) == "caf\xc3\xa9 \xf0\x9f\x98\x80\t\"");
+
+    // round trip
+    char buf[128]{};
+    auto const len = to_json(ev, buf);
+    auto copy = event{0, false, 0., ""};
+    ctb::exception::assert_true(from_json(::std::string_view{buf, len.value()}, copy).has_value());
+    ctb::exception::assert_true(get<"name">(copy) == get<"name">(ev) && get<"ratio">(copy) == get<"ratio">(ev));
+}
+
+inline void runtime_test_from_json_error() noexcept {
+    auto p = point{0, 0};
+    ctb::exception::assert_true(from_json(R"({"x": 1)", p).error() == json_errc::unexpected_end);
+    ctb::exception::assert_true(from_json(R"({"x": 1;})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"x": "1"})", p).error() == json_errc::type_mismatch);
+    ctb::exception::assert_true(from_json(R"({"x": 4294967296})", p).error() == json_errc::out_of_range);
+    ctb::exception::assert_true(from_json(R"([])", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({})", p).value() == 2);
+}
+
+inline void runtime_test_nested() noexcept {
+    using line = namedtuple<names<"from", "to", "label">, point, point, ::std::string>;
+    auto const l = line{point{1, 2}, point{-3, 4}, "a"};
+    char buf[128]{};
+    auto const len = to_json(l, buf);
+    ctb::exception::assert_true(::std::string_view{buf, len.value()} ==
+                                R"({"from":{"x":1,"y":2},"to":{"x":-3,"y":4},"label":"a"})");
+
+    line copy{};
+    ctb::exception::assert_true(from_json(R"({"to": {"y": 5, "x": 6}, "from": {"x": 7}})", copy).has_value());
+    ctb::exception::assert_true(get<"x">(get<"to">(copy)) == 6 && get<"y">(get<"to">(copy)) == 5);
+    ctb::exception::assert_true(get<"x">(get<"from">(copy)) == 7);
+}
+
+consteval void test_number_grammar() noexcept {
+    static_assert(details::json_reader_::number_length_("-0.5e+3,") == 7);
+    static_assert(details::json_reader_::number_length_("0x1") == 1);
+    static_assert(details::json_reader_::number_length_("inf") == 0);
+    static_assert(details::json_reader_::number_length_("-") == 0);
+    static_assert(details::json_reader_::number_length_("1.") == 0);
+    static_assert(details::json_reader_::number_length_(".5") == 0);
+    static_assert(details::json_reader_::number_length_("1e") == 0);
+}
+
+inline void runtime_test_number_grammar() noexcept {
+    auto p = point{0, 0};
+    ctb::exception::assert_true(from_json(R"({"x": 007})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"x": 1.5})", p).error() == json_errc::type_mismatch);
+    ctb::exception::assert_true(from_json(R"({"x": +1})", p).error() == json_errc::type_mismatch);
+    auto ev = event{};
+    ctb::exception::assert_true(from_json(R"({"ratio": inf})", ev).error() == json_errc::type_mismatch);
+    ctb::exception::assert_true(from_json(R"({"ratio": nan})", ev).error() == json_errc::type_mismatch);
+    ctb::exception::assert_true(from_json(R"({"ratio": -infinity})", ev).error() == json_errc::type_mismatch);
+    ctb::exception::assert_true(from_json(R"({"ratio": 2.5e-1})", ev).has_value() && get<"ratio">(ev) == 0.25);
+}
+
+inline void runtime_test_skip_value() noexcept {
+    auto p = point{0, 0};
+    ctb::exception::assert_true(from_json(R"({"u": [1, {"a": [null, -0.5e3, "]"]}, false], "x": 3})", p).has_value());
+    ctb::exception::assert_true(get<"x">(p) == 3);
+    // closers match their openers
+    ctb::exception::assert_true(from_json(R"({"u": [1}, "x": 1})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": {"a": 1]})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": {1: 1}})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": [1 2]})", p).error() == json_errc::syntax_error);
+    // bare tokens are literals or numbers
+    ctb::exception::assert_true(from_json(R"({"u": foo})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": tru})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": truex})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": 01})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": [-]})", p).error() == json_errc::syntax_error);
+    // nesting is bounded
+    auto deep = ::std::string{R"({"u": )"} + ::std::string(300, '[');
+    ctb::exception::assert_true(from_json(deep, p).error() == json_errc::syntax_error);
+}
+
+inline void runtime_test_escapes() noexcept {
+    auto p = point{0, 0};
+    ctb::exception::assert_true(from_json(R"({"u": "\q"})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"u": "\u12"})", p).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"\a": 1})", p).error() == json_errc::syntax_error);
+    auto ev = event{};
+    ctb::exception::assert_true(from_json(R"({"name": "a\x41"})", ev).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"name": "a\'"})", ev).error() == json_errc::syntax_error);
+    ctb::exception::assert_true(from_json(R"({"name": "\/\\\"\b\f\n\r\tA"})", ev).has_value());
+    ctb::exception::assert_true(get<"name">(ev) == "/\\\"\b\f\n\r\tA");
+}
+
+/* more names than the key lookup can hash with a single seed
+ */
+template<typename... Ts>
+using wide_of = namedtuple<wide_names<sizeof...(Ts)>, Ts...>;
+
+inline void runtime_test_wide() noexcept {
+    auto const make = []<::std::size_t... I>(::std::index_sequence<I...>) {
+        return wide_of<decltype(static_cast<::std::int32_t>(I))...>{static_cast<::std::int32_t>(I * 7)...};
+    };
+    auto const w = make(::std::make_index_sequence<66>{});
+    char buf[2048]{};
+    auto const len = to_json(w, buf);
+    decltype(make(::std::make_index_sequence<66>{})) copy{};
+    ctb::exception::assert_true(from_json(::std::string_view{buf, len.value()}, copy).has_value());
+    ctb::exception::assert_true(get<65>(copy) == 65 * 7 && get<0>(copy) == 0);
+}
+
+int main() noexcept {
+    runtime_test_nested();
+    runtime_test_to_json();
+    runtime_test_from_json();
+    runtime_test_from_json_error();
+    runtime_test_number_grammar();
+    runtime_test_skip_value();
+    runtime_test_escapes();
+    runtime_test_wide();
+    return 0;
+}
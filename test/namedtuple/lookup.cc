@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/lookup.hh>
+#include "wide_names.hh"
+
+using namespace ctb::namedtuple;
+
+using config = names<"threads", "verbose", "ratio", "name", "timeout_ms", "retries", "port", "host">;
+
+consteval void test_field_index() noexcept {
+    static_assert(field_index<config>("threads") == 0);
+    static_assert(field_index<config>("ratio") == 2);
+    static_assert(field_index<config>("host") == 7);
+    static_assert(field_index<config>("hos") == 8);
+    static_assert(field_index<config>("hostt") == 8);
+    static_assert(field_index<config>("") == 8);
+    static_assert(field_index<names<"a">>("a") == 0);
+    static_assert(field_index<names<"a">>("b") == 1);
+    static_assert(field_index<names<u8"滑稽", "b">, char8_t>(u8"滑稽") == 0);
+    static_assert(field_index<names<u8"滑稽", "b">, char8_t>(u8"b") == 2);
+    static_assert(field_index<names<u8"滑稽", "b">>("b") == 1);
+}
+
+/* irregular names, more than one perfect hash seed over few slots could handle
+ */
+using wide = wide_names<72, "a", "aa", "aaa", "ab", "ba", "a_1", "a_10", "a_100">;
+
+inline constexpr auto const& wide_names_v = name_views<wide>;
+
+consteval bool test_wide() noexcept {
+    for (::std::size_t i{}; i < ::std::size(wide_names_v); ++i) {
+        if (field_index<wide>(wide_names_v[i]) != i) {
+            return false;
+        }
+    }
+    using table_type = typename decltype(details::get_name_table_<char>(wide{}))::type;
+    static_assert(table_type::table_v_.perfect_);
+    for (::std::size_t i{}; i < ::std::size(wide_names_v); ++i) {
+        if (table_type::find_sorted_(wide_names_v[i]) != i) {
+            return false;
+        }
+    }
+    constexpr auto size = ::std::size(wide_names_v);
+    return field_index<wide>("a_2") == size && field_index<wide>("") == size && field_index<wide>("aaaa") == size &&
+           table_type::find_sorted_("a_2") == size && table_type::find_sorted_("") == size;
+}
+
+static_assert(::std::size(wide_names_v) >= 64);
+static_assert(test_wide());
+
+constexpr bool test_visit_constexpr() noexcept {
+    auto nt = make_namedtuple<"a", "b">(1, 2.);
+    auto found = visit_field(nt, "b", [](auto& field) { field += 1; });
+    return found && get<"b">(nt) == 3. && !visit_field(nt, "c", [](auto&) {});
+}
+
+static_assert(test_visit_constexpr());
+
+constexpr bool test_visit_at() noexcept {
+    auto nt = make_namedtuple<"a", "b">(1, 2.);
+    visit_at(nt, 1, [](auto& field) { field *= 2; });
+    return get<"b">(nt) == 4. && visit_at(nt, 0, [](auto field) { return field; }) == 1.;
+}
+
+static_assert(test_visit_at());
+
+inline void runtime_test_visit() noexcept {
+    auto nt = make_namedtuple<"threads", "verbose", "ratio">(::std::int32_t{4}, false, 0.5);
+
+    // config override: parse a value into the field called name
+    auto set = [&](::std::string_view name, ::std::int32_t value) {
+        return visit_field(nt, name, [value](auto& field) {
+            field = static_cast<::std::decay_t<decltype(field)>>(value);
+        });
+    };
+    ctb::exception::assert_true(set("threads", 16));
+    ctb::exception::assert_true(set("verbose", 1));
+    ctb::exception::assert_true(!set("thread", 1));
+    ctb::exception::assert_true(get<"threads">(nt) == 16);
+    ctb::exception::assert_true(get<"verbose">(nt));
+
+    // projection: read the field called name
+    auto as_double = [&](::std::string_view name) {
+        return visit_field(nt, name, [](auto const& field) { return static_cast<double>(field); });
+    };
+    static_assert(::std::is_same_v<decltype(as_double("ratio")), ctb::exception::optional<double>>);
+    ctb::exception::assert_true(as_double("ratio").value() == 0.5);
+    ctb::exception::assert_true(as_double("threads").value() == 16.);
+    ctb::exception::assert_true(!as_double("nothing").has_value());
+
+    auto const& cnt = nt;
+    ctb::exception::assert_true(visit_field(cnt, "ratio", [](auto& field) {
+        static_assert(::std::is_const_v<::std::remove_reference_t<decltype(field)>>);
+    }));
+}
+
+int main() noexcept {
+    runtime_test_visit();
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/mapped_table.hh>
+
+using namespace ctb::namedtuple;
+
+using trade = namedtuple<names<"id", "price", "qty", "buy">, ::std::uint64_t, double, ::std::int32_t, bool>;
+
+inline constexpr char path[]{"ctb_mapped_table_test.bin"};
+
+template<typename Schema>
+concept mappable_ = requires { typename mapped_table<Schema>; };
+
+template<typename Schema>
+concept writable_ = requires { typename table_writer<Schema>; };
+
+consteval void test_constraints() noexcept {
+    static_assert(mappable_<trade> && writable_<trade>);
+    // rows of no bytes can not be counted from the file size
+    static_assert(!mappable_<namedtuple<names<>>> && !writable_<namedtuple<names<>>>);
+    // the batch buffer is on the heap, moves do not copy it
+    static_assert(sizeof(table_writer<trade>) <= 64);
+}
+
+inline void runtime_test_write_and_map() noexcept {
+    // 21 bytes rows straddle the 4096 bytes batches
+    constexpr ::std::uint64_t count{1000};
+    {
+        auto writer = table_writer<trade, 4096>::create(path);
+        ctb::exception::assert_true(writer.has_value());
+        for (::std::uint64_t i{}; i < count; ++i) {
+            auto const qty = -static_cast<::std::int32_t>(i);
+            auto const row = trade{::std::uint64_t{i}, static_cast<double>(i) * 0.5, ::std::int32_t{qty}, i % 3 == 0};
+            ctb::exception::assert_true(writer.value().append(row));
+        }
+        ctb::exception::assert_true(writer.value().size() == count);
+        ctb::exception::assert_true(writer.value().close());
+    }
+
+    auto table = mapped_table<trade>::open(path);
+    ctb::exception::assert_true(table.has_value());
+    auto const& rows = table.value();
+    ctb::exception::assert_true(rows.size() == count);
+    for (::std::uint64_t i{}; i < count; ++i) {
+        ctb::exception::assert_true(get<"id">(rows[i]) == i);
+        ctb::exception::assert_true(get<"price">(rows[i]) == static_cast<double>(i) * 0.5);
+        ctb::exception::assert_true(get<2>(rows[i]) == -static_cast<::std::int32_t>(i));
+        ctb::exception::assert_true(get<"buy">(rows[i]) == (i % 3 == 0));
+    }
+    auto const row = rows[999].load();
+    ctb::exception::assert_true(get<"id">(row) == 999 && get<"qty">(row) == -999);
+
+    using other = namedtuple<names<"id", "price", "qty", "sell">, ::std::uint64_t, double, ::std::int32_t, bool>;
+    ctb::exception::assert_true(mapped_table<other>::open(path).error() == mapped_errc::schema_mismatch);
+}
+
+inline void runtime_test_open_error() noexcept {
+    ctb::exception::assert_true(mapped_table<trade>::open("ctb_no_such_file.bin").error() == mapped_errc::io_error);
+
+    auto* file = ::std::fopen(path, "wb");
+    ::std::fputs("not a table", file);
+    ::std::fclose(file);
+    ctb::exception::assert_true(mapped_table<trade>::open(path).error() == mapped_errc::bad_header);
+
+    {
+        auto writer = table_writer<trade>::create(path);
+        ctb::exception::assert_true(writer.value().append(trade{1, 1., 1, true}));
+    }
+    ctb::exception::assert_true(mapped_table<trade>::open(path).value().size() == 1);
+}
+
+inline void runtime_test_moved_writer() noexcept {
+    {
+        auto writer = table_writer<trade, 4096>::create(path);
+        ctb::exception::assert_true(writer.value().append(trade{1, 1., 1, true}));
+        auto moved = ::std::move(writer.value());
+        ctb::exception::assert_true(moved.append(trade{2, 2., 2, false}) && moved.size() == 2);
+        // the moved-from writer no longer owns the file
+        ctb::exception::assert_true(writer.value().close());
+    }
+    auto table = mapped_table<trade>::open(path);
+    ctb::exception::assert_true(table.value().size() == 2);
+    ctb::exception::assert_true(get<"id">(table.value()[1]) == 2);
+}
+
+int main() noexcept {
+    runtime_test_write_and_map();
+    runtime_test_open_error();
+    runtime_test_moved_writer();
+    ::std::remove(path);
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/packed.hh>
+
+using namespace ctb::namedtuple;
+
+using state = packed_namedtuple<fields<{"flags", 3}, {"kind", 5}, {"len", 24}>>;
+using wide = packed_namedtuple<fields<{"a", 40}, {"b", 30}, {"c", 64}, {"d", 1}>>;
+
+consteval void test_layout() noexcept {
+    static_assert(sizeof(state) == 8);
+    static_assert(state::slot<0>::shift == 0 && state::slot<1>::shift == 3 && state::slot<2>::shift == 8);
+    static_assert(::std::is_same_v<decltype(get<"flags">(state{})), ::std::uint8_t>);
+    static_assert(::std::is_same_v<decltype(get<"len">(state{})), ::std::uint32_t>);
+
+    // fields do not straddle words: b does not fit after a, c takes a whole word,
+    // so 135 bits take 4 words rather than 3
+    static_assert(sizeof(wide) == 32);
+    static_assert(wide::slot<1>::word == 1 && wide::slot<1>::shift == 0);
+    static_assert(wide::slot<2>::word == 2 && wide::slot<3>::word == 3);
+    static_assert(wide::slot<2>::mask == ~::std::uint64_t{});
+}
+
+constexpr bool test_get_set() noexcept {
+    state s{};
+    set<"flags">(s, 5);
+    set<"kind">(s, 31);
+    set<"len">(s, 0xabcdef);
+    set<"kind">(s, 2);
+    wide w{};
+    set<"c">(w, ~::std::uint64_t{});
+    set<"d">(w, 1);
+    set<0>(w, 0xffffffffff);
+    return get<"flags">(s) == 5 && get<1>(s) == 2 && get<"len">(s) == 0xabcdef && s.words.arr[0] == 0xabcdef15 &&
+           get<"c">(w) == ~::std::uint64_t{} && get<"d">(w) == 1 && get<"b">(w) == 0 && get<"a">(w) == 0xffffffffff;
+}
+
+static_assert(test_get_set());
+
+inline void runtime_test_bulk() noexcept {
+    ::std::array<state, 100> records{};
+    ::std::array<::std::uint32_t, 100> lens{};
+    for (::std::uint32_t i{}; i < lens.size(); ++i) {
+        lens[i] = i * 1000;
+        set<"kind">(records[i], i % 32);
+    }
+    pack<"len">(records, lens);
+
+    ::std::array<::std::uint16_t, 100> kinds{};
+    unpack<"kind">(records, kinds);
+    ::std::array<::std::uint32_t, 100> out{};
+    unpack<"len">(records, out);
+    for (::std::uint32_t i{}; i < lens.size(); ++i) {
+        ctb::exception::assert_true(kinds[i] == i % 32);
+        ctb::exception::assert_true(out[i] == i * 1000);
+        ctb::exception::assert_true(get<"flags">(records[i]) == 0);
+    }
+}
+
+int main() noexcept {
+    runtime_test_bulk();
+    return 0;
+}
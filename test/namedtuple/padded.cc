@@ -0,0 +1,53 @@
+#include <concepts>
+#include <cstdint>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/padded.hh>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+using namespace ctb::namedtuple;
+
+using stats = padded_namedtuple<names<"hits", "misses", "id">, isolated<::std::uint64_t>, isolated<::std::uint64_t>,
+                                ::std::int32_t>;
+
+consteval void test_layout() noexcept {
+    static_assert(sizeof(stats) == 3 * ctb::utils::cache_line_size);
+    static_assert(is_padded_namedtuple<stats>);
+    static_assert(!is_namedtuple<stats>);
+    static_assert(::std::same_as<::std::tuple_element_t<0, stats>, ::std::uint64_t>);
+    static_assert(::std::tuple_size_v<stats> == 3);
+}
+
+consteval void test_get() noexcept {
+    constexpr stats s{1u, 2u, 3};
+    // narrowing arguments are rejected, as brace initialization does
+    static_assert(!::std::constructible_from<stats, int, int, int>);
+    static_assert(get<"hits">(s) == 1);
+    static_assert(get<"misses">(s) == 2);
+    static_assert(get<"id">(s) == 3);
+    static_assert(get<1>(s) == 2);
+    static_assert(::std::same_as<decltype(get<"id">(::std::move(s))), ::std::int32_t const&&>);
+}
+
+inline void test_structured_binding() noexcept {
+    stats s{};
+    ++get<"hits">(s);
+    get<"misses">(s) += 2;
+    auto const& [hits, misses, id] = s;
+    ctb::exception::assert_true(hits == 1);
+    ctb::exception::assert_true(misses == 2);
+    ctb::exception::assert_true(id == 0);
+}
+
+int main() noexcept {
+    test_structured_binding();
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
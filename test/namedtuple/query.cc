@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/query.hh>
+
+using namespace ctb::namedtuple;
+
+using trade = namedtuple<names<"sym", "price", "qty">, ::std::uint32_t, double, ::std::int32_t>;
+using listing = namedtuple<names<"sym", "venue">, ::std::uint32_t, ::std::uint32_t>;
+
+consteval void test_constexpr() noexcept {
+    constexpr auto sel = [] {
+        auto table = soa_vector<trade, 4>{};
+        table.emplace_back(1u, 1., 5);
+        table.emplace_back(2u, 2., 50);
+        table.emplace_back(1u, 3., 500);
+        return filter<"qty">(table, [](auto qty) { return qty > 10; });
+    }();
+    static_assert(sel == ctb::vector::bitset<4>{{1, 2}});
+}
+
+template<typename Table>
+concept groupable_ = requires(Table&& table) { group_by<"sym">(::std::forward<Table>(table)); };
+
+consteval void test_capacity() noexcept {
+    // maps run at no more than half load, power-of-two capacities included
+    static_assert(details::group_capacity_<4> == 16);
+    static_assert(details::group_capacity_<64> == 128);
+    static_assert(details::group_capacity_<200> == 512);
+    using sums_type = decltype(group_by<"sym">(::std::declval<soa_vector<trade, 64> const&>()).sum<"price">());
+    static_assert(sums_type::capacity() >= 2 * 64);
+    // grouped refers to its table, so temporaries are rejected
+    static_assert(groupable_<soa_vector<trade, 8>&> && !groupable_<soa_vector<trade, 8>>);
+}
+
+inline void runtime_test_filter() noexcept {
+    static auto table = soa_vector<trade, 200>{};
+    for (::std::int32_t i{}; i < 150; ++i) {
+        table.emplace_back(static_cast<::std::uint32_t>(i % 3), 1.5, i);
+    }
+    auto sel = filter<"qty">(table, [](auto qty) { return qty >= 100; });
+    ctb::exception::assert_true(sel.popcount() == 50);
+    ctb::exception::assert_true(sel.find_first() == 100);
+    // rows past size() are never selected
+    ctb::exception::assert_true(filter<"qty">(table, [](auto) { return true; }).popcount() == 150);
+
+    auto sel2 = filter<"sym">(table, [](auto sym) { return sym == 0u; }, sel);
+    ctb::exception::assert_true(sel2.popcount() == 16);
+}
+
+inline void runtime_test_group_by() noexcept {
+    static auto table = soa_vector<trade, 64>{};
+    table.emplace_back(7u, 1., 1);
+    table.emplace_back(8u, 2., 2);
+    table.emplace_back(7u, 3., 3);
+    table.emplace_back(9u, 4., 40);
+
+    auto sums = group_by<"sym">(table).sum<"price">();
+    ctb::exception::assert_true(sums.size() == 3);
+    ctb::exception::assert_true(*sums.find(7u) == 4.);
+    ctb::exception::assert_true(*sums.find(9u) == 4.);
+
+    auto small = filter<"qty">(table, [](auto qty) { return qty < 10; });
+    auto qty = group_by<"sym">(table, small).sum<"qty">();
+    ctb::exception::assert_true(qty.size() == 2 && !qty.contains(9u));
+    ctb::exception::assert_true(*qty.find(7u) == 4);
+    ctb::exception::assert_true(*group_by<"sym">(table).count().find(7u) == 2);
+}
+
+inline void runtime_test_hash_join() noexcept {
+    static auto trades = soa_vector<trade, 8>{};
+    trades.emplace_back(1u, 1., 1);
+    trades.emplace_back(2u, 2., 2);
+    trades.emplace_back(3u, 3., 3);
+    static auto listings = soa_vector<listing, 8>{};
+    listings.emplace_back(1u, 100u);
+    listings.emplace_back(3u, 300u);
+    listings.emplace_back(1u, 101u);
+
+    ::std::uint32_t venues[4]{};
+    ::std::size_t n{};
+    hash_join<"sym">(trades, listings, [&](auto t, auto l) {
+        ctb::exception::assert_true(get<"sym">(t) == get<"sym">(l));
+        venues[n++] = get<"venue">(l);
+    });
+    ctb::exception::assert_true(n == 3);
+    ctb::exception::assert_true(venues[0] == 100u && venues[1] == 101u && venues[2] == 300u);
+}
+
+int main() noexcept {
+    runtime_test_filter();
+    runtime_test_group_by();
+    runtime_test_hash_join();
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdint>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/soa_vector.hh>
+
+using namespace ctb::namedtuple;
+
+using trade = namedtuple<names<"id", "price", "qty">, ::std::int64_t, double, ::std::int32_t>;
+
+consteval void test_constexpr() noexcept {
+    constexpr auto table = [] {
+        auto res = soa_vector<trade, 4>{};
+        res.emplace_back(1, 10., 3);
+        res.emplace_back(2, 20., 4);
+        return res;
+    }();
+    static_assert(table.size() == 2);
+    static_assert(get<"price">(table[1]) == 20.);
+    static_assert(get<2>(table[0]) == 3);
+    static_assert(column<"qty">(table)[1] == 4);
+}
+
+inline void runtime_test_columns() noexcept {
+    static auto table = soa_vector<trade, 8>{};
+    for (::std::int32_t i{}; i < 8; ++i) {
+        ctb::exception::assert_true(table.emplace_back(i, i * 1.5, i * 2));
+    }
+    ctb::exception::assert_true(!table.emplace_back(8, 0., 0));
+
+    auto prices = column<"price">(table);
+    ctb::exception::assert_true(prices.size() == 8);
+    ctb::exception::assert_true(reinterpret_cast<::std::uintptr_t>(prices.data()) % ctb::utils::cache_line_size == 0);
+    double sum{};
+    for (auto p : prices) {
+        sum += p;
+    }
+    ctb::exception::assert_true(sum == 1.5 * 28);
+
+    // rows are references into the columns
+    get<"qty">(table[3]) = 100;
+    ctb::exception::assert_true(column<"qty">(table)[3] == 100);
+    auto [id, price, qty] = table[5];
+    ctb::exception::assert_true(id == 5 && price == 7.5 && qty == 10);
+    qty = -1;
+    ctb::exception::assert_true(get<"qty">(table[5]) == -1);
+
+    table.pop_back();
+    ctb::exception::assert_true(table.push_back(make_namedtuple<"id", "price", "qty">(::std::int64_t{9}, 1., 1)));
+    ctb::exception::assert_true(get<"id">(table[7]) == 9);
+
+    auto const& ctable = table;
+    static_assert(::std::is_const_v<::std::remove_reference_t<decltype(get<"id">(ctable[0]))>>);
+}
+
+int main() noexcept {
+    runtime_test_columns();
+    return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <ctb/namedtuple.hh>
+
+/* Generated field names for tests of wide schemas
+ *
+ * wide_names<N, Extra...> is names<...> of N irregular names, 1 to 15 characters
+ * of [a-z0-9_] starting with a letter, followed by Extra. The same N gives the
+ * same names on every compiler.
+ */
+namespace wide_names_ {
+
+[[nodiscard]]
+consteval ::std::uint64_t mix_(::std::uint64_t x) noexcept {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+[[nodiscard]]
+consteval ::std::size_t length_(::std::size_t i) noexcept {
+    return 1 + mix_(i) % 15;
+}
+
+template<::std::size_t I>
+[[nodiscard]]
+consteval auto name_() noexcept {
+    constexpr ::std::string_view letters{"abcdefghijklmnopqrstuvwxyz"};
+    constexpr ::std::string_view tail{"abcdefghijklmnopqrstuvwxyz0123456789_"};
+    char buf[length_(I) + 1]{};
+    for (::std::size_t j{}; j < length_(I); ++j) {
+        auto const h = mix_(I * 64 + j + 1);
+        buf[j] = j == 0 ? letters[h % letters.size()] : tail[h % tail.size()];
+    }
+    return ctb::string::string<char, length_(I) + 1>{buf};
+}
+
+template<ctb::string::string... Extra, ::std::size_t... I>
+auto make_(::std::index_sequence<I...>) -> ctb::namedtuple::names<name_<I>()..., Extra...>;
+
+template<typename Names, ::std::size_t I>
+inline constexpr auto name_v_{ctb::namedtuple::details::get_name<I, Names>()};
+
+template<typename Names, ::std::size_t... I>
+[[nodiscard]]
+consteval auto views_(::std::index_sequence<I...>) noexcept {
+    return ::std::array<::std::string_view, sizeof...(I)>{
+        ::std::string_view{name_v_<Names, I>.begin(), name_v_<Names, I>.size()}...};
+}
+
+template<typename Names>
+inline constexpr auto views_v_{
+    wide_names_::views_<Names>(::std::make_index_sequence<ctb::namedtuple::details::get_size<Names>()>{})};
+
+template<typename Names>
+[[nodiscard]]
+consteval bool distinct_() noexcept {
+    auto const& views = views_v_<Names>;
+    for (::std::size_t i{}; i < views.size(); ++i) {
+        for (::std::size_t j{}; j < i; ++j) {
+            if (views[i] == views[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<::std::size_t N, ctb::string::string... Extra>
+struct wide_names {
+    using type = decltype(wide_names_::make_<Extra...>(::std::make_index_sequence<N>{}));
+    static_assert(wide_names_::distinct_<type>(), "generated names collide, change N or Extra");
+};
+
+} // namespace wide_names_
+
+template<::std::size_t N, ctb::string::string... Extra>
+using wide_names = typename wide_names_::wide_names<N, Extra...>::type;
+
+/* the names of Names as string_views, in declaration order
+ */
+template<typename Names>
+inline constexpr auto const& name_views = wide_names_::views_v_<Names>;
@@ -0,0 +1,85 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <ctb/exception.hh>
+#include <ctb/namedtuple/wire_view.hh>
+
+using namespace ctb::namedtuple;
+
+enum class kind : ::std::uint8_t {
+    trade = 1,
+    quote,
+};
+
+using prefix = namedtuple<names<"len", "kind">, ::std::uint16_t, kind>;
+using header = namedtuple<names<"prefix", "seq", "price">, prefix, ::std::uint32_t, double>;
+using quote = namedtuple<names<"len", "kind", "seq", "price">, ::std::uint16_t, kind, ::std::uint32_t, double>;
+
+consteval void test_layout() noexcept {
+    static_assert(wire_view<prefix>::size == 3);
+    static_assert(wire_view<header>::size == 15);
+    static_assert(::ctb::tuple::details::wire_offset_<2, prefix, ::std::uint32_t, double> == 7);
+    static_assert(!details::is_wire_view_field_<namedtuple<names<"t">, ::ctb::tuple::tuple<int>>>);
+}
+
+inline void runtime_test_big_endian() noexcept {
+    ::std::array<::std::byte, 16> buf{};
+    auto const view = make_wire_view<header>(::std::span<::std::byte>{buf}).value();
+    set<"seq">(view, 0x01020304u);
+    set<"len">(get<"prefix">(view), ::std::uint16_t{0x0a0b});
+    set<1>(get<0>(view), kind::quote);
+    set<"price">(view, 1.5);
+
+    ctb::exception::assert_true(buf[0] == ::std::byte{0x0a} && buf[1] == ::std::byte{0x0b});
+    ctb::exception::assert_true(buf[2] == ::std::byte{2});
+    ctb::exception::assert_true(buf[3] == ::std::byte{1} && buf[6] == ::std::byte{4});
+    ctb::exception::assert_true(buf[7] == ::std::byte{0x3f} && buf[8] == ::std::byte{0xf8} && buf[15] == ::std::byte{});
+
+    // a read-only view of the same bytes
+    auto const ro = make_wire_view<header>(::std::span<::std::byte const>{buf}).value();
+    ctb::exception::assert_true(get<"seq">(ro) == 0x01020304u);
+    ctb::exception::assert_true(get<"len">(get<"prefix">(ro)) == 0x0a0b);
+    ctb::exception::assert_true(get<"kind">(get<"prefix">(ro)) == kind::quote);
+    ctb::exception::assert_true(get<"price">(ro) == 1.5);
+
+    auto const h = ro.load();
+    ctb::exception::assert_true(get<"seq">(h) == 0x01020304u && get<"len">(get<"prefix">(h)) == 0x0a0b);
+
+    // the same bytes as a flat header
+    auto const q = make_wire_view<quote>(::std::span<::std::byte const>{buf}).value().load();
+    ctb::exception::assert_true(get<"len">(q) == 0x0a0b && get<"kind">(q) == kind::quote);
+    ctb::exception::assert_true(get<"seq">(q) == 0x01020304u && get<"price">(q) == 1.5);
+}
+
+inline void runtime_test_little_endian() noexcept {
+    ::std::array<::std::byte, 3> buf{};
+    auto const view = make_wire_view<prefix, ::std::endian::little>(::std::span{buf}).value();
+    view.store(prefix{::std::uint16_t{0x0a0b}, kind::trade});
+    ctb::exception::assert_true(buf[0] == ::std::byte{0x0b} && buf[1] == ::std::byte{0x0a} && buf[2] == ::std::byte{1});
+
+    // the little-endian view reads what encode writes after the schema hash
+    ::std::array<::std::byte, ::ctb::tuple::wire_size<quote>> wire{};
+    auto const flat = quote{::std::uint16_t{7}, kind::quote, ::std::uint32_t{9}, 2.5};
+    ctb::exception::assert_true(encode(flat, wire).has_value());
+    auto const wv = make_wire_view<header, ::std::endian::little>(::std::span<::std::byte const>{wire}.subspan(8))
+                        .value();
+    auto const nested = header{prefix{::std::uint16_t{7}, kind::quote}, ::std::uint32_t{9}, 2.5};
+    ctb::exception::assert_true(encode(nested, wire).has_value());
+    ctb::exception::assert_true(get<"seq">(wv) == 9 && get<"price">(wv) == 2.5);
+    ctb::exception::assert_true(get<"len">(get<"prefix">(wv)) == 7);
+}
+
+inline void runtime_test_too_short() noexcept {
+    ::std::array<::std::byte, 16> buf{};
+    ctb::exception::assert_true(!make_wire_view<header>(::std::span<::std::byte>{buf}.first(14)).has_value());
+    ctb::exception::assert_true(make_wire_view<header>(::std::span<::std::byte>{buf}.first(15)).has_value());
+}
+
+int main() noexcept {
+    runtime_test_big_endian();
+    runtime_test_little_endian();
+    runtime_test_too_short();
+    return 0;
+}
@@ -1,3 +1,8 @@
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
 #include <ctb/exception.hh>
 #include <ctb/tuple.hh>
 
@@ -26,6 +31,84 @@ consteval void test_get() noexcept {
     static_assert(get<float>(tuple{1., 2, 3.f}) == 3.f);
 }
 
+consteval void test_get_reference() noexcept {
+    tuple<int, double> t{1, 2.};
+    auto const& ct = t;
+    static_assert(::std::same_as<decltype(get<0>(t)), int&>);
+    static_assert(::std::same_as<decltype(get<0>(ct)), int const&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(t))), int&&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(ct))), int const&&>);
+    static_assert(::std::same_as<decltype(get<double>(t)), double&>);
+    static_assert(::std::same_as<decltype(get<double>(::std::move(t))), double&&>);
+}
+
+constexpr bool test_get_assign() noexcept {
+    tuple<int, double> t{1, 2.};
+    get<0>(t) = 3;
+    get<double>(t) = 4.;
+    return get<0>(t) == 3 && get<1>(t) == 4.;
+}
+
+static_assert(test_get_assign());
+
+constexpr bool test_forward_as_tuple() noexcept {
+    int a{1};
+    auto t = forward_as_tuple(a, 2.);
+    static_assert(::std::same_as<decltype(t), tuple<int&, double&&>>);
+    get<0>(t) = 3;
+    return a == 3;
+}
+
+static_assert(test_forward_as_tuple());
+
+consteval void test_get_unique_type() noexcept {
+    static_assert(details::has_unique_element_<double, tuple<int, double>>);
+    static_assert(!details::has_unique_element_<int, tuple<int, double, int>>);
+    static_assert(!details::has_unique_element_<float, tuple<int, double>>);
+    static_assert(details::type_index_v_<double, tuple<int, char, double>> == 2);
+}
+
+template<::std::size_t I>
+struct tag {
+    ::std::size_t val;
+};
+
+template<::std::size_t... I>
+consteval bool test_large_tuple(::std::index_sequence<I...>) noexcept {
+    tuple<tag<I>...> t{tag<I>{I}...};
+    return ((get<I>(t).val == I && get<tag<I>>(t).val == I) && ...);
+}
+
+static_assert(test_large_tuple(::std::make_index_sequence<300>{}));
+static_assert(::std::same_as<ctb::utils::pack_indexing_t<2, int, char, double>, double>);
+static_assert(::std::same_as<ctb::utils::pack_indexing_t<0, int>, int>);
+
+consteval void test_compare() noexcept {
+    static_assert(tuple{1, 2.} == tuple{1, 2.});
+    static_assert(tuple{1, 2.} != tuple{1, 3.});
+    static_assert(tuple{1, 2L} == tuple{1L, 2});
+    static_assert(tuple{1, 2.} < tuple{1, 3.} && tuple{2, 0.} > tuple{1, 3.});
+    static_assert((tuple{1, 2} <=> tuple{1, 2}) == ::std::strong_ordering::equal);
+    static_assert(::std::same_as<decltype(tuple{1, 2.} <=> tuple{1, 2.}), ::std::partial_ordering>);
+    static_assert(tuple<>{} == tuple<>{});
+    static_assert(!::std::equality_comparable_with<tuple<int>, tuple<int, int>>);
+    static_assert(details::is_bitwise_comparable_<tuple<::std::uint32_t, ::std::int32_t, ::std::uint64_t>>);
+    // padding, floating point
+    static_assert(!details::is_bitwise_comparable_<tuple<char, int>>);
+    static_assert(!details::is_bitwise_comparable_<tuple<int, float>>);
+    // the memcmp path in a constant expression falls back to the fields
+    static_assert(tuple{1u, 2u} == tuple{1u, 2u} && tuple{1u, 2u} != tuple{1u, 3u});
+}
+
+inline void runtime_test_compare() noexcept {
+    tuple<::std::uint32_t, ::std::int32_t, ::std::uint64_t> a{1u, -2, 3u}, b{a};
+    ctb::exception::assert_true(a == b);
+    get<2>(b) = 4;
+    ctb::exception::assert_true(a != b && a < b);
+    tuple<int, double> c{1, -0.}, d{1, 0.};
+    ctb::exception::assert_true(c == d);
+}
+
 inline void test_structured_binding() noexcept {
     ctb::tuple::tuple t{1, 2};
     auto const& [a, b] = t;
@@ -35,5 +118,6 @@ inline void test_structured_binding() noexcept {
 
 int main() noexcept {
     test_structured_binding();
+    runtime_test_compare();
     return 0;
 }
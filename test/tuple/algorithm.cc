@@ -0,0 +1,162 @@
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/tuple/algorithm.hh>
+#include <ctb/tuple/packed.hh>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+using namespace ctb::tuple;
+
+/* counts its copies
+ */
+struct counted {
+    int* copies;
+
+    constexpr counted(int* copies_) noexcept
+        : copies{copies_} {
+    }
+
+    constexpr counted(counted const& other) noexcept
+        : copies{other.copies} {
+        ++*this->copies;
+    }
+
+    constexpr counted(counted&&) noexcept = default;
+};
+
+struct point {
+    int x;
+    double y;
+};
+
+consteval void test_apply() noexcept {
+    static_assert(apply([](int a, double b) { return a + b; }, tuple{1, 2.}) == 3.);
+    static_assert(apply([](auto... args) { return sizeof...(args); }, tuple<>{}) == 0);
+    static_assert(apply([](char a, double b) { return a + b; }, packed_tuple<char, double>{'\1', 2.}) == 3.);
+    static_assert(!is_tuple_like<::std::tuple<int>>);
+}
+
+constexpr bool test_apply_reference() noexcept {
+    int a{1};
+    tuple<int&, int> t{a, 2};
+    apply([](int& x, int& y) { x = 3, y = 4; }, t);
+    // a reference field stays an lvalue when the tuple is an rvalue
+    apply([](int& x, int&& y) { x += y; }, ::std::move(t));
+    return a == 7;
+}
+
+static_assert(test_apply_reference());
+
+constexpr bool test_for_each() noexcept {
+    tuple<int, double, char> t{1, 2., '\3'};
+    double sum{};
+    for_each(t, [&](auto const& val) { sum += val; });
+    for_each(t, [](auto& val) { val *= 2; });
+    ::std::size_t indices{};
+    for_each_indexed(t, [&](auto i, auto const& val) {
+        static_assert(::std::same_as<decltype(i), ::std::integral_constant<::std::size_t, decltype(i)::value>>);
+        indices = indices * 10 + i;
+        sum += val;
+    });
+    return sum == 18. && indices == 12;
+}
+
+static_assert(test_for_each());
+
+consteval void test_transform() noexcept {
+    constexpr auto t = transform(tuple{1, 2.}, [](auto val) { return val * 2; });
+    static_assert(::std::same_as<decltype(t), tuple<int, double> const>);
+    static_assert(get<0>(t) == 2 && get<1>(t) == 4.);
+}
+
+consteval void test_tuple_cat() noexcept {
+    constexpr auto t = tuple_cat(tuple{1}, tuple<>{}, tuple{2., '\3'}, packed_tuple{4u});
+    static_assert(::std::same_as<decltype(t), tuple<int, double, char, unsigned> const>);
+    static_assert(get<0>(t) == 1 && get<1>(t) == 2. && get<2>(t) == '\3' && get<3>(t) == 4u);
+    static_assert(::std::same_as<decltype(tuple_cat()), tuple<>>);
+}
+
+constexpr bool test_tuple_cat_reference() noexcept {
+    int a{1};
+    auto t = tuple_cat(forward_as_tuple(a), tuple{2});
+    static_assert(::std::same_as<decltype(t), tuple<int&, int>>);
+    get<0>(t) = 3;
+    return a == 3;
+}
+
+static_assert(test_tuple_cat_reference());
+
+consteval void test_make_from_tuple() noexcept {
+    constexpr auto p = make_from_tuple<point>(tuple{1, 2.});
+    static_assert(p.x == 1 && p.y == 2.);
+}
+
+constexpr bool test_no_copy() noexcept {
+    int copies{};
+    tuple<counted, int> t{counted{&copies}, 1};
+    apply([](counted, int) {}, ::std::move(t));
+    auto cat = tuple_cat(::std::move(t), tuple{counted{&copies}});
+    auto moved = transform(::std::move(cat), [](auto&& val) { return ::std::move(val); });
+    static_cast<void>(make_from_tuple<tuple<counted, int, counted>>(::std::move(moved)));
+    // the lvalue is copied
+    apply([](counted, int) {}, t);
+    return copies == 1;
+}
+
+static_assert(test_no_copy());
+
+constexpr bool test_visit_at() noexcept {
+    tuple<int, long, double> t{1, 2, 3.};
+    visit_at(t, 1, [](auto& field) { field += 10; });
+    auto const as_double = [](auto const& field) { return static_cast<double>(field); };
+    static_assert(::std::same_as<decltype(visit_at(t, 0, as_double)), double>);
+    // the common type of the results
+    static_assert(::std::same_as<decltype(visit_at(t, 0, [](auto field) { return field; })), double>);
+    auto const& ct = t;
+    visit_at(ct, 0, [](auto& field) { static_assert(::std::is_const_v<::std::remove_reference_t<decltype(field)>>); });
+    packed_tuple<char, double> p{'a', 4.};
+    return get<1>(t) == 12 && visit_at(t, 2, as_double) == 3. && visit_at(p, 1, as_double) == 4.;
+}
+
+static_assert(test_visit_at());
+
+inline void runtime_test_visit_at() noexcept {
+    tuple<::std::string, int> t{::std::string(64, 'a'), 1};
+    auto const data = get<0>(t).data();
+    ::std::string out{};
+    for (::std::size_t i{}; i < 2; ++i) {
+        visit_at(::std::move(t), i, [&]<typename T>(T&& field) {
+            if constexpr (::std::same_as<T, ::std::string>) {
+                out = ::std::move(field);
+            }
+        });
+    }
+    ctb::exception::assert_true(out.data() == data);
+}
+
+inline void runtime_test_string() noexcept {
+    tuple<::std::string, int> t{::std::string(64, 'a'), 1};
+    auto const data = get<0>(t).data();
+    auto cat = tuple_cat(::std::move(t), tuple{2});
+    ctb::exception::assert_true(get<0>(cat).data() == data);
+    ::std::string out{};
+    apply([&](::std::string&& str, int, int) { out = ::std::move(str); }, ::std::move(cat));
+    ctb::exception::assert_true(out.data() == data);
+}
+
+int main() noexcept {
+    runtime_test_string();
+    runtime_test_visit_at();
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,98 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <ctb/exception.hh>
+#include <ctb/tuple/binary.hh>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+using namespace ctb::tuple;
+
+enum class side : ::std::uint8_t {
+    buy,
+    sell,
+};
+
+consteval void test_byteswap() noexcept {
+    static_assert(ctb::utils::byteswap(::std::uint16_t{0x1234}) == 0x3412);
+    static_assert(ctb::utils::byteswap(::std::uint32_t{0x12345678}) == 0x78563412);
+    static_assert(ctb::utils::byteswap(::std::int64_t{1}) == ::std::int64_t{1} << 56);
+    static_assert(ctb::utils::byteswap(::std::uint8_t{0xab}) == 0xab);
+}
+
+consteval void test_schema() noexcept {
+    static_assert(wire_size<tuple<::std::int32_t, double>> == 8 + 12);
+    static_assert(wire_size<tuple<bool, tuple<side, ::std::uint16_t>>> == 8 + 4);
+    static_assert(schema_hash<tuple<::std::int32_t>> != schema_hash<tuple<::std::uint32_t>>);
+    static_assert(schema_hash<tuple<::std::int32_t>> != schema_hash<tuple<float>>);
+    static_assert(schema_hash<tuple<::std::int32_t, double>> != schema_hash<tuple<double, ::std::int32_t>>);
+    static_assert(schema_hash<tuple<tuple<int>, int>> != schema_hash<tuple<int, tuple<int>>>);
+    static_assert(schema_hash<tuple<side>> == schema_hash<tuple<::std::uint8_t>>);
+    static_assert(details::wire_traits_<tuple<::std::int32_t, float, ::std::uint64_t>>::is_memcpy_);
+    static_assert(!details::wire_traits_<tuple<::std::int32_t, double>>::is_memcpy_); // padding
+}
+
+inline void runtime_test_round_trip() noexcept {
+    using message = tuple<::std::uint64_t, ::std::int32_t, double, bool, side, tuple<::std::int16_t, float>>;
+    auto const msg = message{42, -7, 2.5, true, side::sell, tuple<::std::int16_t, float>{-3, 0.25f}};
+    ::std::array<::std::byte, wire_size<message>> buf{};
+    ctb::exception::assert_true(encode(msg, buf).value() == wire_size<message>);
+
+    // little-endian on the wire
+    ctb::exception::assert_true(buf[8] == ::std::byte{42} && buf[9] == ::std::byte{0});
+    ctb::exception::assert_true(buf[16] == ::std::byte{0xf9} && buf[19] == ::std::byte{0xff});
+
+    auto const res = decode<message>(buf);
+    ctb::exception::assert_true(res.has_value());
+    auto const& out = res.value();
+    ctb::exception::assert_true(get<0>(out) == 42 && get<1>(out) == -7 && get<2>(out) == 2.5);
+    ctb::exception::assert_true(get<3>(out) && get<4>(out) == side::sell);
+    ctb::exception::assert_true(get<0>(get<5>(out)) == -3 && get<1>(get<5>(out)) == 0.25f);
+
+    ctb::exception::assert_true(!encode(msg, ::std::span{buf}.first(wire_size<message> - 1)).has_value());
+    ctb::exception::assert_true(decode<message>(::std::span{buf}.first(10)).error() == binary_errc::too_short);
+    using signed_id = tuple<::std::int64_t, ::std::int32_t, double, bool, side, tuple<::std::int16_t, float>>;
+    ctb::exception::assert_true(decode<signed_id>(buf).error() == binary_errc::schema_mismatch);
+}
+
+inline void runtime_test_memcpy_layout() noexcept {
+    using row = tuple<::std::int32_t, float, ::std::uint64_t>;
+    auto const r = row{1, 2.f, 3};
+    ::std::array<::std::byte, wire_size<row>> buf{};
+    ctb::exception::assert_true(encode(r, buf).has_value());
+    auto const out = decode<row>(buf).value();
+    ctb::exception::assert_true(get<0>(out) == 1 && get<1>(out) == 2.f && get<2>(out) == 3);
+}
+
+inline void runtime_test_invalid_bool() noexcept {
+    using flags = tuple<::std::uint32_t, bool, tuple<::std::int16_t, bool>>;
+    ::std::array<::std::byte, wire_size<flags>> buf{};
+    ctb::exception::assert_true(encode(flags{7u, true, tuple<::std::int16_t, bool>{1, false}}, buf).has_value());
+    ctb::exception::assert_true(decode<flags>(buf).has_value());
+
+    // a bool byte that is neither 0 nor 1, top-level and nested
+    buf[8 + 4] = ::std::byte{2};
+    ctb::exception::assert_true(decode<flags>(buf).error() == binary_errc::invalid_value);
+    buf[8 + 4] = ::std::byte{1};
+    buf[8 + 7] = ::std::byte{0xff};
+    ctb::exception::assert_true(decode<flags>(buf).error() == binary_errc::invalid_value);
+
+    // unchecked loads read any byte but 0 as true
+    ctb::exception::assert_true(details::load_scalar_<::std::endian::little, bool>(&buf[8 + 7]));
+}
+
+int main() noexcept {
+    runtime_test_round_trip();
+    runtime_test_invalid_bool();
+    runtime_test_memcpy_layout();
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <ctb/exception.hh>
+#include <ctb/tuple/hash.hh>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+using namespace ctb::tuple;
+
+consteval void test_hashable() noexcept {
+    static_assert(details::is_hashable_<tuple<int, double>>);
+    static_assert(details::is_hashable_<tuple<>>);
+    struct not_hashable {};
+    static_assert(!details::is_hashable_<tuple<int, not_hashable>>);
+    static_assert(details::hash_mix_(1, 2) != details::hash_mix_(2, 1));
+}
+
+inline void runtime_test_hash() noexcept {
+    using words = tuple<::std::uint32_t, ::std::uint32_t, ::std::uint16_t, ::std::uint16_t>;
+    ::std::hash<words> const hash{};
+    ctb::exception::assert_true(hash(words{1, 2, 3, 4}) == hash(words{1, 2, 3, 4}));
+    ctb::exception::assert_true(hash(words{1, 2, 3, 4}) != hash(words{2, 1, 3, 4}));
+    ctb::exception::assert_true(hash(words{}) != hash(words{0, 0, 0, 1}));
+
+    using mixed = tuple<::std::string, int>;
+    ::std::hash<mixed> const mixed_hash{};
+    ctb::exception::assert_true(mixed_hash(mixed{"a", 1}) == mixed_hash(mixed{"a", 1}));
+    ctb::exception::assert_true(mixed_hash(mixed{"a", 1}) != mixed_hash(mixed{"a", 2}));
+}
+
+inline void runtime_test_unordered_set() noexcept {
+    ::std::unordered_set<tuple<int, int>> set;
+    for (int i{}; i < 100; ++i) {
+        set.insert(tuple{i / 10, i % 10});
+    }
+    ctb::exception::assert_true(set.size() == 100);
+    ctb::exception::assert_true(set.contains(tuple{3, 7}) && !set.contains(tuple{10, 0}));
+}
+
+int main() noexcept {
+    runtime_test_hash();
+    runtime_test_unordered_set();
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,73 @@
+#include <concepts>
+#include <cstdint>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/tuple/packed.hh>
+
+using namespace ctb::tuple;
+
+consteval void test_layout() noexcept {
+    static_assert(sizeof(tuple<char, double, char, double>) == 32);
+    static_assert(sizeof(packed_tuple<char, double, char, double>) == 24);
+    static_assert(sizeof(packed_tuple<char, ::std::int32_t, char, ::std::int16_t>) == 8);
+    static_assert(details::storage_order_v_<char, double, ::std::int16_t, double>[0] == 1);
+    static_assert(details::storage_order_v_<char, double, ::std::int16_t, double>[1] == 3);
+    static_assert(details::storage_order_v_<char, double, ::std::int16_t, double>[2] == 2);
+    static_assert(details::storage_order_v_<char, double, ::std::int16_t, double>[3] == 0);
+    static_assert(::std::is_trivially_copyable_v<packed_tuple<char, double>>);
+}
+
+consteval void test_construct() noexcept {
+    // narrowing arguments are rejected, as brace initialization does
+    static_assert(::std::constructible_from<packed_tuple<char, double>, char, float>);
+    static_assert(!::std::constructible_from<packed_tuple<char, double>, char, int>);
+    static_assert(!::std::constructible_from<packed_tuple<char, ::std::int32_t>, int, double>);
+}
+
+consteval void test_get() noexcept {
+    constexpr packed_tuple<char, double, char, ::std::int32_t> t{'a', 1.5, 'b', 7};
+    static_assert(get<0>(t) == 'a');
+    static_assert(get<1>(t) == 1.5);
+    static_assert(get<2>(t) == 'b');
+    static_assert(get<3>(t) == 7);
+    static_assert(get<double>(t) == 1.5);
+    static_assert(get<::std::int32_t>(t) == 7);
+    static_assert(get<1>(packed_tuple{'a', 2.}) == 2.);
+    static_assert(is_packed_tuple<decltype(t)>);
+    static_assert(!is_packed_tuple<tuple<int>>);
+    static_assert(::std::same_as<::std::tuple_element_t<1, decltype(t)>, double const>);
+    static_assert(::std::tuple_size_v<decltype(t)> == 4);
+}
+
+consteval void test_get_reference() noexcept {
+    packed_tuple<char, double> t{'a', 2.};
+    auto const& ct = t;
+    static_assert(::std::same_as<decltype(get<0>(t)), char&>);
+    static_assert(::std::same_as<decltype(get<0>(ct)), char const&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(t))), char&&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(ct))), char const&&>);
+    static_assert(::std::same_as<decltype(get<double>(t)), double&>);
+    static_assert(::std::same_as<decltype(get<double>(::std::move(t))), double&&>);
+}
+
+constexpr bool test_get_assign() noexcept {
+    packed_tuple<char, double, char> t{'a', 1., 'b'};
+    get<2>(t) = 'c';
+    get<double>(t) = 4.;
+    return get<0>(t) == 'a' && get<1>(t) == 4. && get<2>(t) == 'c';
+}
+
+static_assert(test_get_assign());
+
+inline void test_structured_binding() noexcept {
+    packed_tuple<char, double, char> t{'a', 1., 'b'};
+    auto const& [a, b, c] = t;
+    ctb::exception::assert_true(a == 'a');
+    ctb::exception::assert_true(b == 1.);
+    ctb::exception::assert_true(c == 'b');
+}
+
+int main() noexcept {
+    test_structured_binding();
+    return 0;
+}
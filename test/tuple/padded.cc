@@ -0,0 +1,79 @@
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/tuple/padded.hh>
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-braces"
+#endif
+
+using namespace ctb::tuple;
+
+using counters = padded_tuple<isolated<::std::uint64_t>, isolated<::std::uint64_t>>;
+using mixed = padded_tuple<::std::int32_t, ::std::int32_t, isolated<::std::uint64_t>, char>;
+
+consteval void test_layout() noexcept {
+    constexpr auto line = ctb::utils::cache_line_size;
+    static_assert(alignof(counters) == line);
+    static_assert(sizeof(counters) == 2 * line);
+    static_assert(sizeof(mixed) == 3 * line);
+    static_assert(sizeof(padded_tuple<int, char>) == sizeof(tuple<int, char>));
+    static_assert(::std::is_trivially_copyable_v<counters>);
+}
+
+consteval void test_get() noexcept {
+    constexpr mixed t{1, 2, 3u, 'a'};
+    // narrowing arguments are rejected, as brace initialization does
+    static_assert(!::std::constructible_from<mixed, int, int, int, char>);
+    static_assert(!::std::constructible_from<mixed, double, int, unsigned, char>);
+    static_assert(get<0>(t) == 1);
+    static_assert(get<1>(t) == 2);
+    static_assert(get<2>(t) == 3);
+    static_assert(get<3>(t) == 'a');
+    static_assert(get<::std::uint64_t>(t) == 3);
+    static_assert(get<char>(t) == 'a');
+    static_assert(is_padded_tuple<decltype(t)>);
+    static_assert(!is_padded_tuple<tuple<int>>);
+    static_assert(::std::same_as<::std::tuple_element_t<2, mixed>, ::std::uint64_t>);
+    static_assert(::std::tuple_size_v<mixed> == 4);
+}
+
+consteval void test_get_reference() noexcept {
+    counters t{};
+    auto const& ct = t;
+    static_assert(::std::same_as<decltype(get<0>(t)), ::std::uint64_t&>);
+    static_assert(::std::same_as<decltype(get<0>(ct)), ::std::uint64_t const&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(t))), ::std::uint64_t&&>);
+    static_assert(::std::same_as<decltype(get<0>(::std::move(ct))), ::std::uint64_t const&&>);
+}
+
+inline void test_separate_lines() noexcept {
+    mixed t{1, 2, 3u, 'a'};
+    auto const addr = [](auto const& val) { return reinterpret_cast<::std::uintptr_t>(&val); };
+    auto const line = ctb::utils::cache_line_size;
+    ctb::exception::assert_true(addr(t) % line == 0);
+    ctb::exception::assert_true(addr(get<2>(t)) % line == 0);
+    ctb::exception::assert_true(addr(get<1>(t)) / line != addr(get<2>(t)) / line);
+    ctb::exception::assert_true(addr(get<3>(t)) / line != addr(get<2>(t)) / line);
+}
+
+inline void test_structured_binding() noexcept {
+    counters t{1u, 2u};
+    auto& [a, b] = t;
+    ++a;
+    ctb::exception::assert_true(get<0>(t) == 2);
+    ctb::exception::assert_true(b == 2);
+}
+
+int main() noexcept {
+    test_separate_lines();
+    test_structured_binding();
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
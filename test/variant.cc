@@ -0,0 +1,99 @@
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <ctb/exception.hh>
+#include <ctb/variant.hh>
+
+using namespace ctb::variant;
+
+struct fifteen {
+    char data[15];
+};
+
+template<typename V>
+concept has_public_members = requires(V v) {
+    v.index_ = 5;
+    v.storage_;
+};
+
+consteval void test_layout() noexcept {
+    static_assert(::std::same_as<variant<int, double>::index_type, ::std::uint8_t>);
+    static_assert(sizeof(variant<int, double>) == 16);
+    static_assert(sizeof(variant<char>) == 2);
+    // the tag is in the tail padding of the union, no alternative reaches it
+    static_assert(sizeof(variant<fifteen, ::std::int64_t>) == 16);
+    static_assert(::std::is_trivially_copyable_v<variant<int, double, fifteen>>);
+    static_assert(::std::is_trivially_destructible_v<variant<int, double>>);
+    static_assert(!::std::is_trivially_copyable_v<variant<int, ::std::string>>);
+    static_assert(!::std::is_trivially_destructible_v<variant<int, ::std::string>>);
+    static_assert(::std::is_copy_constructible_v<variant<int, ::std::string>>);
+    // the tag is only written by the variant
+    static_assert(!has_public_members<variant<int, double>>);
+}
+
+consteval void test_construct() noexcept {
+    constexpr variant<int, double> a{};
+    static_assert(a.index() == 0 && get<0>(a) == 0);
+    constexpr variant<int, double> b{2.};
+    static_assert(b.index() == 1 && get<double>(b) == 2.);
+    constexpr variant<int, double> c{::std::in_place_index<1>, 3};
+    static_assert(get<1>(c) == 3.);
+    constexpr variant<int, double> d{::std::in_place_type<int>, 4};
+    static_assert(holds_alternative<int>(d) && !holds_alternative<double>(d));
+    static_assert(get_if<0>(&d) != nullptr && get_if<1>(&d) == nullptr);
+    // no conversion is considered
+    static_assert(!::std::constructible_from<variant<int, double>, long>);
+    static_assert(!::std::constructible_from<variant<int, int>, int>);
+    static_assert(a != b && b == variant<int, double>{2.});
+}
+
+constexpr bool test_visit() noexcept {
+    variant<int, double, char> v{'a'};
+    auto const as_long = [](auto x) { return static_cast<long>(x); };
+    static_assert(::std::same_as<decltype(visit(as_long, v)), long>);
+    bool ok = visit(as_long, v) == 'a';
+    v.emplace<1>(2.5);
+    visit([](auto& x) { x *= 2; }, v);
+    ok = ok && get<1>(v) == 5.;
+    v = variant<int, double, char>{3};
+    return ok && visit(as_long, v) == 3 && v.index() == 0;
+}
+
+static_assert(test_visit());
+
+constexpr bool test_non_trivial() noexcept {
+    variant<int, ::std::string> v{::std::string(40, 'a')};
+    auto copy = v;
+    copy.emplace<int>(1);
+    v = copy;
+    copy = variant<int, ::std::string>{::std::string(40, 'b')};
+    auto moved = ::std::move(copy);
+    return get<int>(v) == 1 && get<1>(moved) == ::std::string(40, 'b');
+}
+
+static_assert(test_non_trivial());
+
+inline void runtime_test_string() noexcept {
+    variant<int, ::std::string> v{::std::string(64, 'x')};
+    auto const* data = get<1>(v).data();
+    auto moved = ::std::move(v);
+    ctb::exception::assert_true(get<1>(moved).data() == data);
+    ::std::string out{};
+    visit(
+        [&]<typename T>(T&& x) {
+            if constexpr (::std::same_as<T, ::std::string>) {
+                out = ::std::move(x);
+            }
+        },
+        ::std::move(moved));
+    ctb::exception::assert_true(out.data() == data);
+    moved = 1;
+    ctb::exception::assert_true(holds_alternative<int>(moved));
+}
+
+int main() noexcept {
+    runtime_test_string();
+    return 0;
+}
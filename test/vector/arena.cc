@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <vector>
+#include <ctb/exception.hh>
+#include <ctb/vector/arena.hh>
+
+using namespace ctb::vector;
+
+struct Point {
+    int x, y;
+
+    Point(int x_, int y_) noexcept
+        : x{x_},
+          y{y_} {
+    }
+};
+
+inline void test_arena() noexcept {
+    auto buf = arena<64, 16>{};
+    auto* a = buf.allocate(3, 1);
+    ctb::exception::assert_true(a != nullptr && buf.used() == 3);
+    auto* p = buf.create<Point>(1, 2);
+    ctb::exception::assert_true(p != nullptr && p->x == 1 && p->y == 2);
+    ctb::exception::assert_true(reinterpret_cast<::std::uintptr_t>(p) % alignof(Point) == 0);
+    ctb::exception::assert_true(buf.used() == 4 + sizeof(Point));
+    ctb::exception::assert_true(buf.owns(p));
+
+    // the latest allocation is given back
+    auto* b = buf.allocate(8, 8);
+    buf.deallocate(b, 8);
+    ctb::exception::assert_true(buf.allocate(8, 8) == b);
+
+    ctb::exception::assert_true(buf.allocate(64, 1) == nullptr);
+    buf.reset();
+    ctb::exception::assert_true(buf.used() == 0);
+    ctb::exception::assert_true(buf.allocate(64, 1) != nullptr);
+}
+
+inline void test_arena_huge_request() noexcept {
+    auto buf = arena<64>{};
+    // sizes near SIZE_MAX would wrap an address computation
+    ctb::exception::assert_true(buf.allocate(SIZE_MAX - 8, 8) == nullptr);
+    ctb::exception::assert_true(buf.allocate(SIZE_MAX, 1) == nullptr);
+    ctb::exception::assert_true(buf.used() == 0);
+    ctb::exception::assert_true(buf.allocate(60, 1) != nullptr);
+    ctb::exception::assert_true(buf.allocate(4, 8) == nullptr);
+    ctb::exception::assert_true(buf.allocate(SIZE_MAX - 2, 1) == nullptr);
+    ctb::exception::assert_true(buf.used() == 60 && buf.allocate(4, 1) != nullptr);
+}
+
+inline void test_pool() noexcept {
+    auto objs = pool<Point, 3>{};
+    auto* a = objs.create(1, 1);
+    auto* b = objs.create(2, 2);
+    auto* c = objs.create(3, 3);
+    ctb::exception::assert_true(a != nullptr && b != nullptr && c != nullptr);
+    ctb::exception::assert_true(objs.create(4, 4) == nullptr);
+    ctb::exception::assert_true(objs.size() == 3);
+
+    objs.destroy(b);
+    objs.destroy(a);
+    ctb::exception::assert_true(objs.size() == 1);
+    // free list is LIFO
+    ctb::exception::assert_true(objs.create(5, 5) == a);
+    ctb::exception::assert_true(objs.create(6, 6) == b);
+    ctb::exception::assert_true(c->x == 3 && b->x == 6);
+    ctb::exception::assert_true(!objs.owns(&c->y));
+}
+
+#if defined(__cpp_lib_memory_resource)
+inline void test_memory_resource() noexcept {
+    auto buf = arena<1024>{};
+    auto res = ctb::vector::memory_resource{buf};
+    auto vec = ::std::pmr::vector<int>{&res};
+    vec.reserve(16);
+    for (int i{}; i < 16; ++i) {
+        vec.push_back(i);
+    }
+    ctb::exception::assert_true(buf.owns(vec.data()));
+    ctb::exception::assert_true(vec[15] == 15);
+
+    auto small = pool<::std::uint64_t, 4>{};
+    auto small_res = ctb::vector::memory_resource{small};
+    auto* p = small_res.allocate(8, 8);
+    ctb::exception::assert_true(small.owns(p) && small.size() == 1);
+    // too big for a slot, served by upstream
+    auto* q = small_res.allocate(64, 8);
+    ctb::exception::assert_true(!small.owns(q));
+    small_res.deallocate(q, 64, 8);
+    small_res.deallocate(p, 8, 8);
+    ctb::exception::assert_true(small.size() == 0);
+}
+#endif
+
+int main() noexcept {
+    test_arena();
+    test_arena_huge_request();
+    test_pool();
+#if defined(__cpp_lib_memory_resource)
+    test_memory_resource();
+#endif
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <ctb/exception.hh>
+#include <ctb/vector/bitset.hh>
+
+using namespace ctb::vector;
+
+template<bitset<256> Mask>
+struct Matcher {
+    static constexpr bool match(unsigned char ch) noexcept {
+        return Mask.test(ch);
+    }
+};
+
+consteval void test_init() noexcept {
+    constexpr auto _1 = bitset<130>{{0, 5, 64, 129}};
+    static_assert(_1.test(0) && _1.test(5) && _1.test(64) && _1.test(129));
+    static_assert(!_1.test(1) && !_1.test(63));
+    static_assert(_1.popcount() == 4);
+    static_assert(_1.word_count == 3);
+    constexpr auto _2 = bitset<256>{ctb::string::string{"aeiou"}};
+    static_assert(_2.test('a') && _2.test('u') && !_2.test('b'));
+    static_assert(bitset<8>{}.none());
+}
+
+consteval void test_nttp() noexcept {
+    using vowel = Matcher<bitset<256>{ctb::string::string{"aeiou"}}>;
+    static_assert(vowel::match('e'));
+    static_assert(!vowel::match('z'));
+}
+
+consteval void test_set_op() noexcept {
+    constexpr auto a = bitset<100>{{1, 2, 3, 70}};
+    constexpr auto b = bitset<100>{{2, 3, 4, 99}};
+    static_assert((a & b) == bitset<100>{{2, 3}});
+    static_assert((a | b) == bitset<100>{{1, 2, 3, 4, 70, 99}});
+    static_assert((a ^ b) == bitset<100>{{1, 4, 70, 99}});
+    static_assert(andnot(a, b) == bitset<100>{{1, 70}});
+}
+
+consteval void test_find() noexcept {
+    constexpr auto a = bitset<200>{{3, 64, 190}};
+    static_assert(a.find_first() == 3);
+    static_assert(a.find_next(4) == 64);
+    static_assert(a.find_next(65) == 190);
+    static_assert(a.find_next(191) == a.npos);
+    static_assert(bitset<10>{}.find_first() == bitset<10>::npos);
+}
+
+inline void runtime_test_iter() noexcept {
+    auto a = bitset<300>{};
+    a.set(0).set(63).set(64).set(299);
+    ::std::size_t expected[]{0, 63, 64, 299};
+    ::std::size_t n{};
+    for (auto i : a) {
+        ctb::exception::assert_true(i == expected[n++]);
+    }
+    ctb::exception::assert_true(n == 4);
+    a.reset(63);
+    ctb::exception::assert_true(a.popcount() == 3);
+    ctb::exception::assert_true(a.find_next(1) == 64);
+    for ([[maybe_unused]] auto i : bitset<300>{}) {
+        ctb::exception::terminate();
+    }
+}
+
+int main() noexcept {
+    runtime_test_iter();
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <ctb/exception.hh>
+#include <ctb/vector/flat_map.hh>
+
+using namespace ctb::vector;
+
+enum class opcode : unsigned char {
+    nop = 0,
+    load = 7,
+    store = 9,
+    jump = 200,
+};
+
+constexpr auto status_text = make_flat_map<int, char const*>({
+    {404, "Not Found"},
+    {200, "OK"},
+    {500, "Internal Server Error"},
+    {301, "Moved Permanently"},
+    {201, "Created"},
+    {418, "I'm a teapot"},
+    {204, "No Content"},
+});
+
+consteval void test_find() noexcept {
+    static_assert(status_text.size() == 7);
+    static_assert(status_text.contains(200));
+    static_assert(status_text.contains(418));
+    static_assert(!status_text.contains(100));
+    static_assert(!status_text.contains(600));
+    static_assert(!status_text.contains(300));
+    static_assert(status_text.find(404).value()[0] == 'N');
+    static_assert(status_text.find(202).has_value() == false);
+    static_assert(status_text.at(301)[0] == 'M');
+}
+
+consteval void test_layout() noexcept {
+    constexpr auto m = make_flat_map<int, int>({{1, 10}, {2, 20}, {3, 30}});
+    // Eytzinger order of a 3 element tree: root 2, then 1, 3
+    static_assert(m.keys.arr[1] == 2 && m.keys.arr[2] == 1 && m.keys.arr[3] == 3);
+    static_assert(m.values.arr[1] == 20);
+}
+
+consteval void test_enum() noexcept {
+    constexpr auto cost = make_flat_map<opcode, int>({
+        {opcode::store, 3},
+        {opcode::nop, 0},
+        {opcode::jump, 2},
+        {opcode::load, 4},
+    });
+    static_assert(cost.at(opcode::load) == 4);
+    static_assert(cost.at(opcode::jump) == 2);
+    static_assert(!cost.contains(static_cast<opcode>(8)));
+}
+
+inline void runtime_test_find() noexcept {
+    for (int i{}; i < 700; ++i) {
+        bool const expected = i == 200 || i == 201 || i == 204 || i == 301 || i == 404 || i == 418 || i == 500;
+        ctb::exception::assert_true(status_text.contains(i) == expected);
+    }
+}
+
+int main() noexcept {
+    runtime_test_find();
+    return 0;
+}
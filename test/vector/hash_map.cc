@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <ctb/exception.hh>
+#include <ctb/vector/hash_map.hh>
+
+using namespace ctb::vector;
+
+consteval auto make_squares() noexcept {
+    auto m = inline_hash_map<int, int, 64>{};
+    for (int i{}; i < 40; ++i) {
+        m.insert(i, i * i);
+    }
+    m.erase(3);
+    return m;
+}
+
+consteval void test_constexpr() noexcept {
+    constexpr auto m = make_squares();
+    static_assert(m.size() == 39);
+    static_assert(*m.find(7) == 49);
+    static_assert(!m.contains(3));
+    static_assert(!m.contains(40));
+}
+
+consteval void test_insert() noexcept {
+    constexpr auto m = [] {
+        auto res = inline_hash_map<int, int, 16>{};
+        res.insert(1, 1);
+        res.insert(1, 2); // already exists
+        res.insert_or_assign(2, 2);
+        res.insert_or_assign(2, 3);
+        return res;
+    }();
+    static_assert(*m.find(1) == 1);
+    static_assert(*m.find(2) == 3);
+}
+
+inline void runtime_test_full() noexcept {
+    auto m = inline_hash_map<::std::uint32_t, ::std::uint32_t, 32>{};
+    for (::std::uint32_t i{}; i < 32; ++i) {
+        ctb::exception::assert_true(m.insert(i * 7919u, i));
+    }
+    ctb::exception::assert_true(m.size() == 32);
+    // no room and no heap
+    ctb::exception::assert_true(!m.insert(1u, 1u));
+    ctb::exception::assert_true(m.try_emplace(1u, 1u) == nullptr);
+    for (::std::uint32_t i{}; i < 32; ++i) {
+        ctb::exception::assert_true(*m.find(i * 7919u) == i);
+    }
+
+    // tombstones are reused
+    ctb::exception::assert_true(m.erase(7919u));
+    ctb::exception::assert_true(!m.erase(7919u));
+    ctb::exception::assert_true(!m.contains(7919u));
+    ctb::exception::assert_true(m.insert(1u, 42u));
+    ctb::exception::assert_true(*m.find(1u) == 42u);
+
+    ::std::uint32_t sum{};
+    m.for_each([&](auto, auto v) { sum += v; });
+    ctb::exception::assert_true(sum == 31u * 32u / 2u - 1u + 42u);
+}
+
+inline void runtime_test_churn() noexcept {
+    auto m = inline_hash_map<int, int, 128>{};
+    for (int round{}; round < 50; ++round) {
+        for (int i{}; i < 100; ++i) {
+            ctb::exception::assert_true(m.insert(round * 1000 + i, i));
+        }
+        for (int i{}; i < 100; ++i) {
+            ctb::exception::assert_true(*m.find(round * 1000 + i) == i);
+            ctb::exception::assert_true(m.erase(round * 1000 + i));
+        }
+        ctb::exception::assert_true(m.empty());
+    }
+}
+
+int main() noexcept {
+    runtime_test_full();
+    runtime_test_churn();
+    return 0;
+}
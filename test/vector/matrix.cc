@@ -0,0 +1,75 @@
+#include <ctb/exception.hh>
+#include <ctb/vector/matrix.hh>
+
+using namespace ctb::vector;
+
+consteval void test_init() noexcept {
+    constexpr auto m = matrix<int, 2, 3>{{{1, 2, 3}, {4, 5, 6}}};
+    static_assert(m(0, 2) == 3);
+    static_assert(m(1, 0) == 4);
+    static_assert(m.data.arr[3] == 4);
+    constexpr auto c = matrix<int, 2, 3, layout::col_major>{{{1, 2, 3}, {4, 5, 6}}};
+    static_assert(c.data.arr[1] == 4);
+    static_assert(c == m);
+    constexpr auto b = matrix<int, 4, 4, layout::blocked<2>>::identity();
+    static_assert(b(3, 3) == 1 && b(3, 2) == 0);
+    static_assert(b.data.arr[4 * 3 + 3] == 1);
+}
+
+consteval void test_matmul() noexcept {
+    constexpr auto a = matrix<int, 2, 3>{{{1, 2, 3}, {4, 5, 6}}};
+    constexpr auto b = matrix<int, 3, 2, layout::col_major>{{{7, 8}, {9, 10}, {11, 12}}};
+    static_assert(matmul(a, b) == matrix<int, 2, 2>{{{58, 64}, {139, 154}}});
+    static_assert(matmul(a, matrix<int, 3, 3>::identity()) == a);
+}
+
+consteval void test_transpose() noexcept {
+    constexpr auto a = matrix<int, 2, 3>{{{1, 2, 3}, {4, 5, 6}}};
+    static_assert(transpose(a) == matrix<int, 3, 2>{{{1, 4}, {2, 5}, {3, 6}}});
+    static_assert(transpose(transpose(a)) == a);
+}
+
+consteval void test_apply() noexcept {
+    constexpr auto a = matrix<int, 2, 2>{{{1, 2}, {3, 4}}};
+    static_assert(apply(a, [](int x) { return x * 2.; }) == matrix<double, 2, 2>{{{2., 4.}, {6., 8.}}});
+}
+
+consteval void test_inverse() noexcept {
+    constexpr auto a = matrix<double, 2, 2>{{{2., 1.}, {0., 4.}}};
+    static_assert(determinant(a) == 8.);
+    static_assert(inverse(a).value() == matrix<double, 2, 2>{{{.5, -.125}, {0., .25}}});
+    static_assert(matmul(a, inverse(a).value()) == matrix<double, 2, 2>::identity());
+    constexpr auto s = matrix<double, 3, 3>{{{1., 2., 3.}, {2., 4., 6.}, {0., 1., 1.}}};
+    static_assert(inverse(s).has_value() == false);
+    // rank 2, the last pivot is rounded to about -5e-18 instead of 0
+    constexpr auto r = matrix<double, 3, 3>{{{.01, .02, .03}, {.04, .05, .06}, {.07, .08, .09}}};
+    static_assert(determinant(r) == 0. && inverse(r).has_value() == false);
+    // the tolerance is relative to the entries, small matrices are not singular
+    constexpr auto tiny = matrix<double, 2, 2>{{{1e-20, 0.}, {0., 1e-20}}};
+    static_assert(inverse(tiny).has_value() && inverse(tiny).value()(1, 1) == 1e20);
+    constexpr auto p = matrix<double, 3, 3, layout::col_major>{{{0., 1., 0.}, {1., 0., 0.}, {0., 0., 2.}}};
+    static_assert(determinant(p) == -2.);
+    static_assert(inverse(p).value() == matrix<double, 3, 3>{{{0., 1., 0.}, {1., 0., 0.}, {0., 0., .5}}});
+}
+
+inline void runtime_test_matmul() noexcept {
+    auto a = matrix<float, 4, 4>::identity();
+    a(0, 3) = 2.f;
+    auto b = matrix<float, 4, 4, layout::blocked<2>>{};
+    for (::std::size_t r{}; r < 4; ++r) {
+        for (::std::size_t c{}; c < 4; ++c) {
+            b(r, c) = static_cast<float>(r * 4 + c);
+        }
+    }
+    auto res = matmul(a, b);
+    ctb::exception::assert_true(res(0, 0) == 0.f + 2.f * 12.f);
+    ctb::exception::assert_true(res(3, 1) == 13.f);
+
+    auto big = matrix<int, 20, 20>::identity();
+    ctb::exception::assert_true(matmul(big, big) == big);
+}
+
+int main() noexcept {
+    runtime_test_matmul();
+    return 0;
+}
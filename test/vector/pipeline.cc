@@ -0,0 +1,79 @@
+#include <ctb/exception.hh>
+#include <ctb/vector/pipeline.hh>
+
+using namespace ctb::vector;
+
+constexpr auto square = [](auto x) {
+    return x * x;
+};
+
+constexpr auto is_even = [](auto x) {
+    return x % 2 == 0;
+};
+
+constexpr auto plus = [](auto acc, auto x) {
+    return acc + x;
+};
+
+constexpr auto nums = vector{1, 2, 3, 4, 5, 6};
+
+consteval void test_map() noexcept {
+    static_assert((nums | map(square) | to_vector()) == vector{1, 4, 9, 16, 25, 36});
+    static_assert((nums | map(square) | count()) == 6);
+}
+
+consteval void test_filter() noexcept {
+    static_assert((nums | filter(is_even) | count()) == 3);
+    static_assert((nums | filter(is_even) | map(square) | reduce(plus, 0)) == 4 + 16 + 36);
+    static_assert((nums | map(square) | filter(is_even) | reduce(plus, 0)) == 4 + 16 + 36);
+}
+
+consteval void test_zip() noexcept {
+    constexpr auto weights = vector{6, 5, 4, 3, 2, 1};
+    constexpr auto dot = zip(nums, weights) | map([](auto t) {
+                             auto [a, b] = t;
+                             return a * b;
+                         }) |
+                         reduce(plus, 0);
+    static_assert(dot == 6 + 10 + 12 + 12 + 10 + 6);
+}
+
+consteval void test_collect() noexcept {
+    constexpr auto evens = collect<nums>([](auto const& src) {
+        return src | filter(is_even) | map(square);
+    });
+    static_assert(evens.size() == 3);
+    static_assert(evens == vector{4, 16, 36});
+}
+
+inline void runtime_test_pipeline() noexcept {
+    auto vec = vector{3u, 1u, 4u, 1u, 5u, 9u, 2u, 6u};
+    auto sum = vec | filter([](auto x) { return x > 2u; }) | reduce(plus, 0u);
+    ctb::exception::assert_true(sum == 3u + 4u + 5u + 9u + 6u);
+
+    unsigned visited{};
+    vec | map(square) | for_each([&](auto x) { visited += x; });
+    ctb::exception::assert_true(visited == 9u + 1u + 16u + 1u + 25u + 81u + 4u + 36u);
+}
+
+inline void runtime_test_temporary_source() noexcept {
+    // the pipeline owns a temporary source, so it can be consumed later
+    auto evens = vector{1, 2, 3, 4} | filter(is_even);
+    static_assert(sizeof(evens) >= sizeof(vector<int, 4>));
+    auto scratch = vector{9, 9, 9, 9, 9, 9, 9, 9};
+    ctb::exception::assert_true((scratch | reduce(plus, 0)) == 72);
+    ctb::exception::assert_true((evens | reduce(plus, 0)) == 2 + 4);
+    ctb::exception::assert_true((evens | map(square) | count()) == 2);
+
+    // an lvalue source is still referenced, not copied
+    auto vec = vector{1, 2, 3, 4};
+    auto squares = vec | map(square);
+    vec.arr[0] = 5;
+    ctb::exception::assert_true((squares | reduce(plus, 0)) == 25 + 4 + 9 + 16);
+}
+
+int main() noexcept {
+    runtime_test_pipeline();
+    runtime_test_temporary_source();
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <thread>
+#include <ctb/exception.hh>
+#include <ctb/vector/ring.hh>
+
+using namespace ctb::vector;
+
+inline void test_spsc() noexcept {
+    auto ring = spsc_ring<int, 4>{};
+    ctb::exception::assert_true(ring.push(1) && ring.push(2) && ring.push(3) && ring.push(4));
+    ctb::exception::assert_true(!ring.push(5));
+    int out{};
+    ctb::exception::assert_true(ring.pop(out) && out == 1);
+    ctb::exception::assert_true(ring.push(5));
+
+    int batch[8]{};
+    ctb::exception::assert_true(ring.pop_n(batch, 8) == 4);
+    ctb::exception::assert_true(batch[0] == 2 && batch[3] == 5);
+    ctb::exception::assert_true(!ring.pop(out));
+
+    // wraps around the end of the storage
+    int src[]{6, 7, 8, 9, 10};
+    ctb::exception::assert_true(ring.push_n(src, 5) == 4);
+    ctb::exception::assert_true(ring.size() == 4);
+    ctb::exception::assert_true(ring.pop_n(batch, 3) == 3);
+    ctb::exception::assert_true(batch[0] == 6 && batch[2] == 8);
+}
+
+inline void test_spsc_threads() noexcept {
+    static auto ring = spsc_ring<::std::uint64_t, 64>{};
+    constexpr ::std::uint64_t n{100000};
+    auto producer = ::std::thread{[] {
+        for (::std::uint64_t i{1}; i <= n;) {
+            ::std::uint64_t batch[]{i, i + 1, i + 2};
+            auto const pushed = ring.push_n(batch, i + 2 <= n ? 3 : n - i + 1);
+            if (pushed == 0) {
+                ::std::this_thread::yield();
+            }
+            i += pushed;
+        }
+    }};
+    ::std::uint64_t expected{1};
+    while (expected <= n) {
+        ::std::uint64_t val{};
+        if (ring.pop(val)) {
+            ctb::exception::assert_true(val == expected++);
+        } else {
+            ::std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+inline void test_mpsc() noexcept {
+    auto ring = mpsc_ring<int, 2>{};
+    ctb::exception::assert_true(ring.push(1) && ring.push(2));
+    ctb::exception::assert_true(!ring.push(3));
+    int out{};
+    ctb::exception::assert_true(ring.pop(out) && out == 1);
+    ctb::exception::assert_true(ring.push(3));
+    int batch[4]{};
+    ctb::exception::assert_true(ring.pop_n(batch, 4) == 2);
+    ctb::exception::assert_true(batch[0] == 2 && batch[1] == 3);
+}
+
+inline void test_mpsc_threads() noexcept {
+    static auto ring = mpsc_ring<::std::uint64_t, 128>{};
+    constexpr ::std::uint64_t n{20000};
+    auto produce = [](::std::uint64_t id) {
+        for (::std::uint64_t i{}; i < n;) {
+            if (ring.push(id << 32 | i)) {
+                ++i;
+            } else {
+                ::std::this_thread::yield();
+            }
+        }
+    };
+    auto p1 = ::std::thread{produce, 0};
+    auto p2 = ::std::thread{produce, 1};
+    ::std::uint64_t next[2]{};
+    while (next[0] + next[1] < 2 * n) {
+        ::std::uint64_t val{};
+        if (ring.pop(val)) {
+            auto const id = val >> 32;
+            // every producer's elements keep their order
+            ctb::exception::assert_true((val & 0xffffffffu) == next[id]++);
+        } else {
+            ::std::this_thread::yield();
+        }
+    }
+    p1.join();
+    p2.join();
+}
+
+int main() noexcept {
+    test_spsc();
+    test_spsc_threads();
+    test_mpsc();
+    test_mpsc_threads();
+    return 0;
+}